@@ -0,0 +1,724 @@
+#include "fixedbigint.h"
+#include "binarybiginteger.h"
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <new>
+#include <atomic>
+#include <thread>
+#include <cstring>
+#include <sstream>
+
+std::atomic < long long > allocations(0);
+
+// every form of the global operator new counts one allocation and gets its
+// memory from malloc or aligned_alloc, and every form of operator delete
+// hands it back to free, so that no pair of them mixes allocators
+void *Allocate(size_t size)
+{
+	++allocations;
+	void *p = malloc(size ? size : 1);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void *Allocate(size_t size, std::align_val_t align)
+{
+	++allocations;
+	// aligned_alloc wants a nonzero multiple of the alignment
+	size_t alignment = static_cast < size_t >(align);
+	size_t rounded = size ? (size + alignment - 1) / alignment * alignment : alignment;
+	void *p = aligned_alloc(alignment, rounded);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void Release(void *p)
+{
+	free(p);
+}
+
+void *operator new(size_t size)
+{
+	return Allocate(size);
+}
+
+void *operator new[](size_t size)
+{
+	return Allocate(size);
+}
+
+void *operator new(size_t size, std::align_val_t align)
+{
+	return Allocate(size, align);
+}
+
+void *operator new[](size_t size, std::align_val_t align)
+{
+	return Allocate(size, align);
+}
+
+void operator delete(void *p) noexcept
+{
+	Release(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+	Release(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	Release(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+	Release(p);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept
+{
+	Release(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept
+{
+	Release(p);
+}
+
+void operator delete(void *p, size_t, std::align_val_t) noexcept
+{
+	Release(p);
+}
+
+void operator delete[](void *p, size_t, std::align_val_t) noexcept
+{
+	Release(p);
+}
+
+struct Measure
+{
+	long long allocations;
+	double time;
+};
+
+template < class F >
+Measure Run(F f, int n)
+{
+	long long start_allocations = allocations;
+	// wall time, so that the parallel reductions show their speedup
+	std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now();
+	f(n);
+	Measure res;
+	res.allocations = allocations - start_allocations;
+	res.time = std::chrono::duration < double >(std::chrono::steady_clock::now() - t).count();
+	return res;
+}
+
+template < class F >
+void Report(const char *name, F f, int n)
+{
+	Measure m = Run(f, n);
+	printf("%-28s allocs/op = %8.3f    time = %.3f\n", name, 1.0 * m.allocations / n, m.time);
+}
+
+void SmallSums(int n)
+{
+	BigInteger x = 0, y = 123456789;
+	for (int i = 0; i < n; ++i)
+	{
+		x = x + y;
+		x = x - 7;
+	}
+}
+
+void SmallProducts(int n)
+{
+	BigInteger x = 987654321, y = 123456789;
+	for (int i = 0; i < n; ++i)
+	{
+		BigInteger z = x * y;
+		z %= 1000000007;
+		x = z + 1;
+	}
+}
+
+BigInteger LongValue(int digits, char fill)
+{
+	std::string s(digits, fill);
+	s[0] = '9';
+	return BigInteger(s);
+}
+
+void LongSums(int n)
+{
+	BigInteger x = LongValue(90000, '3'), y = LongValue(90000, '7');
+	for (int i = 0; i < n; ++i)
+	{
+		x += y;
+		x -= y;
+		x += y;
+	}
+}
+
+void LongAccumulation(int n)
+{
+	BigInteger y = LongValue(90000, '7');
+	BigInteger::Accumulator acc;
+	for (int i = 0; i < n; ++i)
+		acc += y;
+	acc.result();
+}
+
+void SmallRationals(int n)
+{
+	Rational r = 0;
+	for (int i = 0; i < n; ++i)
+	{
+		r += Rational(BigInteger(i % 5 + 1), BigInteger(i % 7 + 2));
+		if (r > 1000)
+			r = 0;
+	}
+}
+
+void Harmonic(int n)
+{
+	Rational h = 0;
+	for (int i = 1; i <= n; ++i)
+		h += Rational(BigInteger(1), BigInteger(i));
+	h.toString();
+}
+
+void LazyHarmonic(int n)
+{
+	size_t limit = Rational::lazyThreshold();
+	Rational::lazyThreshold() = 64;
+	Harmonic(n);
+	Rational::lazyThreshold() = limit;
+}
+
+void LongDecimals(int n)
+{
+	Rational r(BigInteger(1), BigInteger(7));
+	for (int i = 0; i < n; ++i)
+		r.asDecimal(10000);
+}
+
+void NaiveFactorial(int n)
+{
+	BigInteger x = 1;
+	for (int i = 2; i <= n; ++i)
+		x *= i;
+}
+
+void TreeFactorial(int n)
+{
+	factorial(n, 1);
+}
+
+void ParallelFactorial(int n)
+{
+	factorial(n);
+}
+
+void ParallelBinomial(int n)
+{
+	binomial(2 * n, n);
+}
+
+// 2048-bit odd modulus and exponent, as in RSA
+const BigInteger Modulus = LongValue(617, '3') + 2;
+const BigInteger Exponent = LongValue(616, '5');
+
+void NaivePowMod(int n)
+{
+	for (int i = 0; i < n; ++i)
+	{
+		BigInteger res = 1, base = i + 2, e = Exponent;
+		while (e)
+		{
+			if (e % 2 != 0)
+				res = res * base % Modulus;
+			base = base * base % Modulus;
+			e /= 2;
+		}
+	}
+}
+
+void ContextPowMod(int n)
+{
+	BigInteger::ModContext context(Modulus);
+	for (int i = 0; i < n; ++i)
+		context.powMod(i + 2, Exponent);
+}
+
+// a chain of modular products, each step one mulMod of values already
+// reduced
+void ContextMulMod(int n)
+{
+	BigInteger::ModContext context(Modulus);
+	BigInteger x = Exponent % Modulus;
+	for (int i = 0; i < n; ++i)
+		x = context.mulMod(x, Exponent);
+}
+
+// modular products of up to 128-bit values, which fit in FixedBigInt<256>;
+// the result is stored to a volatile, since the fixed-width loop does not
+// allocate and would otherwise be optimised away
+template < class Integer >
+void ModularProducts(int n)
+{
+	Integer m(std::string("170141183460469231731687303715884105727")), x(std::string(38, '7'));
+	for (int i = 0; i < n; ++i)
+		x = x * x % m + i;
+	volatile bool keep = (bool)x;
+	(void)keep;
+}
+
+// n fractions with parts of 1 to 27 digits from a fixed linear congruential
+// generator, kept both as pairs and as Rationals so that neither sort below
+// pays for parsing or reduction
+std::vector < std::pair < BigInteger, BigInteger > > fractions;
+std::vector < Rational > rationals;
+
+void MakeFractions(int n)
+{
+	unsigned long long state = 1;
+	std::string parts[2];
+	for (int i = 0; i < n; ++i)
+	{
+		for (std::string &s : parts)
+		{
+			state = state * 6364136223846793005ull + 1442695040888963407ull;
+			s.assign(1 + (state >> 33) % 27, '0');
+			for (char &c : s)
+			{
+				state = state * 6364136223846793005ull + 1442695040888963407ull;
+				c = '0' + (state >> 33) % 10;
+			}
+			s[0] = '1' + (state >> 40) % 9;
+		}
+		if (i % 2)
+			parts[0].insert(0, 1, '-');
+		fractions.emplace_back(BigInteger(parts[0]), BigInteger(parts[1]));
+		rationals.emplace_back(fractions.back().first, fractions.back().second);
+	}
+}
+
+// how Rational::operator< compared before the estimates
+void CrossProductSort(int)
+{
+	std::vector < std::pair < BigInteger, BigInteger > > v = fractions;
+	std::sort(v.begin(), v.end(), [](const std::pair < BigInteger, BigInteger > &x, const std::pair < BigInteger, BigInteger > &y)
+	{
+		return x.first * y.second < y.first * x.second;
+	});
+}
+
+void RationalSort(int)
+{
+	std::vector < Rational > v = rationals;
+	std::sort(v.begin(), v.end());
+}
+
+void NaivePow(int n)
+{
+	BigInteger x = 1;
+	for (int i = 0; i < n; ++i)
+		x *= 3;
+}
+
+void SquaringPow(int n)
+{
+	BigInteger::pow(3, n);
+}
+
+void Roots(int n)
+{
+	BigInteger x = LongValue(100000, '4');
+	for (int i = 0; i < n; ++i)
+		BigInteger::iroot(x, i % 3 + 2);
+}
+
+void Expressions(int n)
+{
+	BigInteger a = LongValue(90, '1'), b = LongValue(90, '2'), c = LongValue(90, '3'), d = LongValue(90, '4'), e = LongValue(180, '5');
+	BigInteger x;
+	for (int i = 0; i < n; ++i)
+		x = a * b + c * d + e;
+}
+
+void FusedExpressions(int n)
+{
+	BigInteger a = LongValue(90, '1'), b = LongValue(90, '2'), c = LongValue(90, '3'), d = LongValue(90, '4'), e = LongValue(180, '5');
+	BigInteger x;
+	for (int i = 0; i < n; ++i)
+	{
+		x = e;
+		x.addMul(a, b);
+		x.addMul(c, d);
+	}
+}
+
+// Karatsuba products and Knuth divisions, whose temporaries come
+// from the scratch arena of the running thread
+void Batch(int n)
+{
+	BigInteger x = LongValue(1500, '6'), y = LongValue(1200, '8');
+	for (int i = 0; i < n; ++i)
+	{
+		BigInteger p = x * y;
+		p /= x;
+	}
+}
+
+void ParallelBatch(int n)
+{
+	std::vector < std::thread > workers;
+	for (int i = 0; i < 4; ++i)
+		workers.push_back(std::thread(Batch, n / 4));
+	for (size_t i = 0; i < workers.size(); ++i)
+		workers[i].join();
+}
+
+void ScopedBatch(int n)
+{
+	ScratchArena arena;
+	ScratchArena::Scope scope(arena);
+	Batch(n);
+}
+
+// size sweep: every operation on operands of 1, 4, 16, ... limbs, timed
+// until a run takes MIN_TIME, with the results kept in a volatile sink so
+// that nothing is optimised away
+const double MIN_TIME = 0.05;
+// Rational operators reduce by a gcd, which is quadratic in the size
+const int RATIONAL_MAX_LIMBS = 4096;
+volatile size_t sink;
+
+struct SweepResult
+{
+	std::string op;
+	int limbs;
+	long long iterations;
+	double ns;
+	double allocs;
+};
+
+std::vector < SweepResult > results;
+
+// deterministic value of exactly `limbs` limbs
+BigInteger RandomValue(int limbs, unsigned seed)
+{
+	std::string s(9 * limbs, '0');
+	for (size_t i = 0; i < s.size(); ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		s[i] = '0' + (seed >> 16) % 10;
+	}
+	if (s[0] == '0')
+		s[0] = '1';
+	return BigInteger(s);
+}
+
+template < class F >
+void Sweep(const char *op, int limbs, F f)
+{
+	for (long long iterations = 1;; iterations *= 2)
+	{
+		long long start_allocations = allocations;
+		std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now();
+		for (long long i = 0; i < iterations; ++i)
+			f();
+		double time = std::chrono::duration < double >(std::chrono::steady_clock::now() - t).count();
+		if (time >= MIN_TIME)
+		{
+			SweepResult res = { op, limbs, iterations, time * 1e9 / iterations, 1.0 * (allocations - start_allocations) / iterations };
+			printf("%-12s %8d %16.1f ns/op %10.3f allocs/op\n", op, limbs, res.ns, res.allocs);
+			fflush(stdout);
+			results.push_back(res);
+			return;
+		}
+	}
+}
+
+void SweepSize(int limbs)
+{
+	BigInteger x = RandomValue(limbs, 1), y = RandomValue(limbs, 2), u = RandomValue(2 * limbs, 3);
+	BigInteger z = x;
+	++z;
+	std::string text = x.toString();
+	std::vector < unsigned char > bytes(x.serializedLength()), out(bytes.size());
+	bytes.resize(x.serialize(bytes.data()));
+	BigInteger w;
+	Sweep("+", limbs, [&]() { sink = (x + y).limbs(); });
+	Sweep("-", limbs, [&]() { sink = (x - y).limbs(); });
+	Sweep("*", limbs, [&]() { sink = (x * y).limbs(); });
+	Sweep("/", limbs, [&]() { sink = (u / y).limbs(); });
+	Sweep("%", limbs, [&]() { sink = (u % y).limbs(); });
+	Sweep("toString", limbs, [&]() { sink = x.toString().size(); });
+	Sweep("parse", limbs, [&]() { sink = BigInteger(text).limbs(); });
+	Sweep("serialize", limbs, [&]() { sink = x.serialize(out.data()); });
+	Sweep("deserialize", limbs, [&]() { sink = w.deserialize(bytes.data(), bytes.data() + bytes.size()) - bytes.data(); });
+	Sweep("<", limbs, [&]() { sink = x < z; });
+	if (limbs > RATIONAL_MAX_LIMBS)
+		return;
+	Rational p(x, y), q(y, u);
+	Sweep("Rational +", limbs, [&]() { sink = (p + q) < p; });
+	Sweep("Rational *", limbs, [&]() { sink = (p * q) < p; });
+	Sweep("Rational <", limbs, [&]() { sink = p < q; });
+}
+
+void WriteJson(const char *path)
+{
+	FILE *f = fopen(path, "w");
+	if (!f)
+	{
+		fprintf(stderr, "cannot write %s\n", path);
+		return;
+	}
+	fprintf(f, "{\n  \"context\": {\"min_time\": %g, \"karatsuba\": %d, \"toom3\": %d, \"ntt\": %d, \"newton\": %d},\n  \"benchmarks\": [\n",
+		MIN_TIME, BigInteger::thresholds().karatsuba, BigInteger::thresholds().toom3, BigInteger::thresholds().ntt, BigInteger::thresholds().newton);
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const SweepResult &r = results[i];
+		fprintf(f, "    {\"name\": \"%s/%d\", \"op\": \"%s\", \"limbs\": %d, \"iterations\": %lld, \"ns_per_op\": %.1f, \"allocs_per_op\": %.3f}%s\n",
+			r.op.c_str(), r.limbs, r.op.c_str(), r.limbs, r.iterations, r.ns, r.allocs, i + 1 < results.size() ? "," : "");
+	}
+	fprintf(f, "  ]\n}\n");
+	fclose(f);
+}
+
+// --check: products of 10^d - 1 by itself and by 10^d + 1, whose digits are
+// known, on operands of 1 to CHECK_MAX_LIMBS limbs with the NTT kept out of
+// the way and every small Karatsuba threshold, for BigInteger also with
+// every small Toom-3 threshold or none, and for BinaryBigInteger
+const int CHECK_MAX_LIMBS = 40;
+const int CHECK_MAX_THRESHOLD = 8;
+
+// setting names the thresholds in effect in the failure messages
+template < class Integer >
+int CheckProducts(const char *name, const char *setting)
+{
+	int failures = 0;
+	for (int digits = 1; digits <= 9 * CHECK_MAX_LIMBS; ++digits)
+	{
+		Integer nines(std::string(digits, '9')), next = nines + 2;
+		std::string square = std::string(digits - 1, '9') + '8' + std::string(digits - 1, '0') + '1';
+		std::string product(2 * digits, '9');
+		if ((nines * nines).toString() != square)
+		{
+			printf("%s: (10^%d - 1)^2 wrong with %s\n", name, digits, setting);
+			++failures;
+		}
+		if ((nines * next).toString() != product)
+		{
+			printf("%s: (10^%d - 1) * (10^%d + 1) wrong with %s\n", name, digits, digits, setting);
+			++failures;
+		}
+	}
+	return failures;
+}
+
+// ModContext::mulMod against * and % for an odd modulus, which takes the
+// Montgomery path, and an even one, which takes Barrett's
+int CheckMulMod()
+{
+	int failures = 0;
+	for (const BigInteger &m : { Modulus, Modulus + 1 })
+	{
+		BigInteger::ModContext context(m);
+		BigInteger x = Exponent, y = -Exponent / 7;
+		for (int i = 0; i < 100; ++i)
+		{
+			BigInteger expected = x * y % m;
+			if (expected < 0)
+				expected += m;
+			if (context.mulMod(x, y) != expected)
+			{
+				printf("ModContext::mulMod wrong for an %s modulus at step %d\n", m % 2 != 0 ? "odd" : "even", i);
+				++failures;
+			}
+			y = x + i;
+			x = expected;
+		}
+	}
+	return failures;
+}
+
+// BigInteger::ArrayView over a serialized array: the intact array reads
+// back, and with any byte of the offsets overwritten open either refuses
+// it or yields values that can all be read (under ASan this catches reads
+// past the buffer); raising the first value's end offset, entry 1, past the
+// limbs must be refused
+int CheckArrayView()
+{
+	int failures = 0;
+	std::vector < BigInteger > values = { Modulus, -Exponent, 7 };
+	std::ostringstream os;
+	BigInteger::serializeArray(values.begin(), values.end(), os);
+	std::string text = os.str();
+	std::vector < unsigned char > bytes(text.begin(), text.end());
+	BigInteger::ArrayView view;
+	if (!view.open(bytes.data(), bytes.size()) || (view.size() != values.size()))
+	{
+		printf("ArrayView rejects an intact array\n");
+		return 1;
+	}
+	for (size_t i = 0; i < values.size(); ++i)
+		if (view[i] != values[i])
+		{
+			printf("ArrayView reads value %d wrong\n", (int)i);
+			++failures;
+		}
+	size_t entries_end = 16 + 8 * (values.size() + 1);
+	for (size_t i = 16; i < entries_end; ++i)
+		for (unsigned char c : { 0x01, 0x10, 0xFF })
+		{
+			std::vector < unsigned char > corrupt = bytes;
+			corrupt[i] = c;
+			if (view.open(corrupt.data(), corrupt.size()))
+				for (size_t j = 0; j < view.size(); ++j)
+					view[j].limbs();
+		}
+	std::vector < unsigned char > corrupt = bytes;
+	corrupt[27] = 0x10;
+	if (view.open(corrupt.data(), corrupt.size()))
+	{
+		printf("ArrayView accepts an offset past the limbs\n");
+		++failures;
+	}
+	return failures;
+}
+
+// a value moved from, by construction or by assignment, is 0 and goes on
+// working like any other
+template < class Integer >
+int CheckMovedFrom(const char *name)
+{
+	int failures = 0;
+	Integer x(std::string(100, '7')), y(std::string(90, '3'));
+	Integer z = std::move(x);
+	y = std::move(z);
+	for (Integer *v : { &x, &z })
+	{
+		bool zero = !*v && (*v == 0) && (v->toString() == "0");
+		*v += 5;
+		if (!zero || (v->toString() != "5"))
+		{
+			printf("%s: a value moved from by %s is not a usable 0\n", name, v == &x ? "construction" : "assignment");
+			++failures;
+		}
+	}
+	if (y != Integer(std::string(100, '7')))
+	{
+		printf("%s: move assignment lost the value\n", name);
+		++failures;
+	}
+	return failures;
+}
+
+int Check()
+{
+	BigInteger::Thresholds saved = BigInteger::thresholds();
+	BigInteger::thresholds().ntt = INT_MAX;
+	int failures = 0;
+	char setting[64];
+	for (int t = 0; t <= CHECK_MAX_THRESHOLD; ++t)
+		for (int u = 0; u <= CHECK_MAX_THRESHOLD + 1; ++u)
+		{
+			BigInteger::thresholds().karatsuba = t;
+			BigInteger::thresholds().toom3 = u <= CHECK_MAX_THRESHOLD ? u : INT_MAX;
+			snprintf(setting, sizeof(setting), "karatsuba = %d, toom3 = %d", t, BigInteger::thresholds().toom3);
+			failures += CheckProducts < BigInteger >("BigInteger", setting);
+		}
+	BigInteger::thresholds() = saved;
+	BinaryBigInteger::Thresholds binary_saved = BinaryBigInteger::thresholds();
+	for (int t = 0; t <= CHECK_MAX_THRESHOLD; ++t)
+	{
+		BinaryBigInteger::thresholds().karatsuba = t;
+		snprintf(setting, sizeof(setting), "karatsuba = %d", t);
+		failures += CheckProducts < BinaryBigInteger >("BinaryBigInteger", setting);
+	}
+	BinaryBigInteger::thresholds() = binary_saved;
+	failures += CheckMulMod();
+	failures += CheckArrayView();
+	failures += CheckMovedFrom < BigInteger >("BigInteger");
+	failures += CheckMovedFrom < BinaryBigInteger >("BinaryBigInteger");
+	printf("%s\n", failures ? "check FAILED" : "check passed");
+	return failures ? 1 : 0;
+}
+
+// benchmark                     fixed workloads below
+// benchmark --sweep [--max-limbs N] [--json FILE]
+//                               every operation on 1, 4, 16, ... limbs up
+//                               to N (default 2^20)
+// benchmark --check             multiplication against known products,
+//                               ModContext::mulMod against * and % and
+//                               ArrayView::open on corrupt offsets, and the
+//                               use of values moved from
+int main(int argc, char **argv)
+{
+	bool sweep = false;
+	int max_limbs = 1 << 20;
+	const char *json = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--check"))
+			return Check();
+		else if (!strcmp(argv[i], "--sweep"))
+			sweep = true;
+		else if (!strcmp(argv[i], "--max-limbs") && (i + 1 < argc))
+			max_limbs = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--json") && (i + 1 < argc))
+			json = argv[++i];
+		else
+		{
+			fprintf(stderr, "usage: %s [--check | --sweep [--max-limbs N] [--json FILE]]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (sweep)
+	{
+		for (int limbs = 1; limbs <= max_limbs; limbs *= 4)
+			SweepSize(limbs);
+		if (json)
+			WriteJson(json);
+		return 0;
+	}
+
+	const int n = 1000000;
+	Report("BigInteger small + -", SmallSums, n);
+	Report("BigInteger small * %", SmallProducts, n);
+	Report("BigInteger 10^4 limbs +=", LongSums, n / 1000);
+	Report("Accumulator 10^4 limbs +=", LongAccumulation, n / 1000);
+	Report("Rational small +=", SmallRationals, n / 10);
+	Report("a * b + c * d + e", Expressions, n / 10);
+	Report("e + a * b + c * d by addMul", FusedExpressions, n / 10);
+	Report("Rational harmonic sum", Harmonic, n / 500);
+	Report("Rational lazy harmonic sum", LazyHarmonic, n / 500);
+	Report("Rational 10^4 digit decimal", LongDecimals, n / 10000);
+	Report("factorial by *=", NaiveFactorial, n / 20);
+	Report("factorial product tree", TreeFactorial, n / 20);
+	Report("factorial parallel tree", ParallelFactorial, n / 20);
+	Report("binomial parallel tree", ParallelBinomial, n / 20);
+	Report("3^n by *=", NaivePow, n / 10);
+	Report("3^n by squaring", SquaringPow, n / 10);
+	Report("2nd-4th roots of 10^5 digits", Roots, 3);
+	Report("batch * /", Batch, n / 1000);
+	Report("batch * / on 4 threads", ParallelBatch, n / 1000);
+	Report("batch * / in a scoped arena", ScopedBatch, n / 1000);
+	Report("2048-bit powmod by * %", NaivePowMod, n / 100000);
+	Report("2048-bit ModContext::powMod", ContextPowMod, n / 100000);
+	Report("2048-bit ModContext::mulMod", ContextMulMod, n / 100);
+	Report("128-bit * % by BigInteger", ModularProducts < BigInteger >, n / 10);
+	Report("128-bit * % by FixedBigInt", ModularProducts < FixedBigInt < 256 > >, n / 10);
+	MakeFractions(n);
+	Report("sort 10^6 by cross products", CrossProductSort, n);
+	Report("sort 10^6 Rationals", RationalSort, n);
+	return 0;
+}
@@ -2,167 +2,1461 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <algorithm>
+#include <utility>
+#include <cstdlib>
+#include <cmath>
+#include <climits>
+#include <thread>
+#include <future>
 
-void ReverseString(std::string &s)
+// vector of trivially copyable values that keeps up to N of them inline and
+// goes to the heap only beyond that
+template < class T, int N >
+class SmallVector
 {
-	std::string s1 = s;
-	s = "";
-	for (int i = 1; i <= (int)s1.size(); ++i)
-		s += s1[s1.size() - i];
-}
+public:
+	SmallVector()
+		: data_(inline_)
+		, size_(0)
+		, capacity_(N)
+	{}
+
+	SmallVector(const SmallVector &other)
+		: data_(inline_)
+		, size_(0)
+		, capacity_(N)
+	{
+		assign(other.begin(), other.end());
+	}
+
+	SmallVector(SmallVector &&other) noexcept
+		: data_(inline_)
+		, size_(0)
+		, capacity_(N)
+	{
+		steal(other);
+	}
+
+	~SmallVector()
+	{
+		release();
+	}
+
+	SmallVector &operator=(const SmallVector &other)
+	{
+		if (this != &other)
+			assign(other.begin(), other.end());
+		return *this;
+	}
+
+	SmallVector &operator=(SmallVector &&other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			steal(other);
+		}
+		return *this;
+	}
+
+	size_t size() const
+	{
+		return size_;
+	}
+
+	bool empty() const
+	{
+		return !size_;
+	}
+
+	T *data()
+	{
+		return data_;
+	}
+
+	const T *data() const
+	{
+		return data_;
+	}
+
+	T *begin()
+	{
+		return data_;
+	}
+
+	const T *begin() const
+	{
+		return data_;
+	}
+
+	T *end()
+	{
+		return data_ + size_;
+	}
+
+	const T *end() const
+	{
+		return data_ + size_;
+	}
+
+	T &operator[](size_t i)
+	{
+		return data_[i];
+	}
+
+	const T &operator[](size_t i) const
+	{
+		return data_[i];
+	}
+
+	T &back()
+	{
+		return data_[size_ - 1];
+	}
+
+	const T &back() const
+	{
+		return data_[size_ - 1];
+	}
+
+	void reserve(size_t n)
+	{
+		if (n <= capacity_)
+			return;
+		size_t capacity = std::max(n, 2 * capacity_);
+		T *cur = new T[capacity];
+		std::copy_n(data_, size_, cur);
+		release();
+		data_ = cur;
+		capacity_ = capacity;
+	}
+
+	void push_back(const T &x)
+	{
+		if (size_ == capacity_)
+		{
+			T copy = x;
+			reserve(size_ + 1);
+			data_[size_++] = copy;
+		}
+		else
+			data_[size_++] = x;
+	}
+
+	void pop_back()
+	{
+		--size_;
+	}
+
+	void clear()
+	{
+		size_ = 0;
+	}
+
+	void resize(size_t n, const T &x = T())
+	{
+		reserve(n);
+		if (n > size_)
+			std::fill(data_ + size_, data_ + n, x);
+		size_ = n;
+	}
+
+	void assign(size_t n, const T &x)
+	{
+		size_ = 0;
+		resize(n, x);
+	}
+
+	void assign(const T *first, const T *last)
+	{
+		size_t n = last - first;
+		if (n > capacity_)
+		{
+			T *cur = new T[n];
+			std::copy(first, last, cur);
+			release();
+			data_ = cur;
+			capacity_ = n;
+		}
+		else
+			std::copy(first, last, data_);
+		size_ = n;
+	}
+
+	T *insert(T *pos, size_t n, const T &x)
+	{
+		size_t index = pos - data_;
+		reserve(size_ + n);
+		std::copy_backward(data_ + index, data_ + size_, data_ + size_ + n);
+		std::fill_n(data_ + index, n, x);
+		size_ += n;
+		return data_ + index;
+	}
+
+	T *erase(T *first, T *last)
+	{
+		std::copy(last, end(), first);
+		size_ -= last - first;
+		return first;
+	}
+
+	void swap(SmallVector &other)
+	{
+		SmallVector tmp = std::move(other);
+		other = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+	bool operator==(const SmallVector &other) const
+	{
+		return (size_ == other.size_) && std::equal(begin(), end(), other.begin());
+	}
+
+	bool operator!=(const SmallVector &other) const
+	{
+		return !(*this == other);
+	}
+
+private:
+	void release()
+	{
+		if (data_ != inline_)
+			delete[] data_;
+		data_ = inline_;
+		capacity_ = N;
+	}
+
+	void steal(SmallVector &other)
+	{
+		if (other.data_ == other.inline_)
+		{
+			std::copy_n(other.inline_, other.size_, inline_);
+			size_ = other.size_;
+		}
+		else
+		{
+			data_ = other.data_;
+			size_ = other.size_;
+			capacity_ = other.capacity_;
+			other.data_ = other.inline_;
+			other.capacity_ = N;
+		}
+		other.size_ = 0;
+	}
+
+	T *data_;
+	size_t size_;
+	size_t capacity_;
+	T inline_[N];
+};
+
+// stack-ordered scratch memory for the multiplication and division kernels.
+// Blocks are allocated on first use and kept, so once an arena has warmed up
+// the temporaries of an operation never reach malloc, and whatever an
+// operation took is handed back when it returns. Every thread draws from its
+// own thread_local arena unless a Scope binds it to another one; an arena
+// must only be used by one thread at a time
+class ScratchArena
+{
+public:
+	// requests above this size go straight to the heap, so that one huge
+	// product does not pin its buffers in the arena for good
+	static const size_t LARGE = 1 << 22;
+
+	ScratchArena()
+		: block_(0)
+		, used_(0)
+	{}
+
+	ScratchArena(const ScratchArena &) = delete;
+	ScratchArena &operator=(const ScratchArena &) = delete;
+
+	~ScratchArena()
+	{
+		release();
+	}
+
+	// frees all blocks; nothing may be taken from the arena at this point
+	void release()
+	{
+		for (size_t i = 0; i < blocks_.size(); ++i)
+			delete[] blocks_[i].data;
+		blocks_.clear();
+		block_ = used_ = 0;
+	}
+
+	// bytes held in blocks
+	size_t capacity() const
+	{
+		size_t res = 0;
+		for (size_t i = 0; i < blocks_.size(); ++i)
+			res += blocks_[i].size;
+		return res;
+	}
+
+	// the arena the kernels of the calling thread draw from
+	static ScratchArena &current()
+	{
+		if (ScratchArena *arena = active())
+			return *arena;
+		static thread_local ScratchArena arena;
+		return arena;
+	}
+
+	// binds the calling thread to an arena until the scope ends, e.g. to keep
+	// one warmed-up arena for a whole batch or to release it afterwards
+	class Scope
+	{
+	public:
+		explicit Scope(ScratchArena &arena)
+			: previous_(active())
+		{
+			active() = &arena;
+		}
+
+		Scope(const Scope &) = delete;
+		Scope &operator=(const Scope &) = delete;
+
+		~Scope()
+		{
+			active() = previous_;
+		}
+
+	private:
+		ScratchArena *previous_;
+	};
+
+	// n uninitialised values of a trivial type from the current arena,
+	// returned on destruction; buffers end in the reverse order of creation
+	template < class T >
+	class Buffer
+	{
+	public:
+		explicit Buffer(size_t n)
+			: arena_(current())
+			, block_(arena_.block_)
+			, used_(arena_.used_)
+			, heap_(n * sizeof(T) > LARGE)
+		{
+			data_ = heap_ ? new T[n] : static_cast < T * >(arena_.take(n * sizeof(T)));
+		}
+
+		Buffer(const Buffer &) = delete;
+		Buffer &operator=(const Buffer &) = delete;
+
+		~Buffer()
+		{
+			if (heap_)
+				delete[] data_;
+			else
+			{
+				arena_.block_ = block_;
+				arena_.used_ = used_;
+			}
+		}
+
+		T *data()
+		{
+			return data_;
+		}
+
+		T &operator[](size_t i)
+		{
+			return data_[i];
+		}
+
+	private:
+		ScratchArena &arena_;
+		size_t block_, used_;
+		bool heap_;
+		T *data_;
+	};
+
+private:
+	static const size_t ALIGN = 16;
+	static const size_t MIN_BLOCK = 1 << 16;
+
+	struct Block
+	{
+		char *data;
+		size_t size;
+	};
+
+	static ScratchArena *&active()
+	{
+		static thread_local ScratchArena *arena = 0;
+		return arena;
+	}
+
+	void *take(size_t bytes)
+	{
+		bytes = (bytes + ALIGN - 1) / ALIGN * ALIGN;
+		while ((block_ < blocks_.size()) && (used_ + bytes > blocks_[block_].size))
+		{
+			++block_;
+			used_ = 0;
+		}
+		if (block_ == blocks_.size())
+		{
+			size_t size = std::max(bytes, blocks_.empty() ? MIN_BLOCK : 2 * blocks_.back().size);
+			Block block = { new char[size], size };
+			blocks_.push_back(block);
+		}
+		void *res = blocks_[block_].data + used_;
+		used_ += bytes;
+		return res;
+	}
+
+	std::vector < Block > blocks_;
+	size_t block_, used_;
+};
+
+class BigInteger
+{
+private:
+	static const int K = 9;
+	static const int INF = 1e9;
+	// the longest convolution supported by all three NTT primes
+	static const int NTT_MAX_LOG = 23;
+	// limbs kept inline before the first heap allocation; one or two cover
+	// most values in practice
+	static const int INLINE_LIMBS = 4;
+	typedef SmallVector < int, INLINE_LIMBS > Limbs;
+	Limbs a;
+	bool minus;
+
+	// *this += (y_minus ? -|y| : |y|): one magnitude comparison fixes the sign
+	// of the result, then a single carry or borrow pass runs over the limbs
+	// in place, without copying either operand
+	void sum(const BigInteger &y, bool y_minus)
+	{
+		int n = a.size(), m = y.a.size();
+		if (minus == y_minus)
+		{
+			a.resize(std::max(n, m) + 1, 0);
+			addLimbs(a.data(), a.size(), y.a.data(), m);
+		}
+		else if (compareLimbs(a.data(), n, y.a.data(), m) >= 0)
+			subLimbs(a.data(), n, y.a.data(), m);
+		else
+		{
+			a.resize(m, 0);
+			subLimbsFrom(a.data(), y.a.data(), m);
+			minus = y_minus;
+		}
+		removeLeadingZeros();
+	}
+
+	void removeLeadingZeros()
+	{
+		while ((a.size() > 1) && (a.back() == 0))
+			a.pop_back();
+		if ((a.size() == 1) && (a[0] == 0))
+			minus = false;
+	}
+
+	static BigInteger fromLimbs(const int *x, int n)
+	{
+		BigInteger res;
+		if (n > 0)
+			res.a.assign(x, x + n);
+		res.removeLeadingZeros();
+		return res;
+	}
+
+	// r[0 .. n) += x[0 .. m), m <= n; returns the carry out of r[n - 1]
+	static int addLimbs(int *r, int n, const int *x, int m)
+	{
+		int carry = 0;
+		int i = 0;
+		for (; i < m; ++i)
+		{
+			int cur = r[i] + x[i] + carry;
+			carry = cur >= INF;
+			r[i] = carry ? cur - INF : cur;
+		}
+		for (; carry && (i < n); ++i)
+		{
+			carry = (++r[i] == INF);
+			if (carry)
+				r[i] = 0;
+		}
+		return carry;
+	}
+
+	// r[0 .. n) -= x[0 .. m), m <= n; returns the borrow out of r[n - 1]
+	static int subLimbs(int *r, int n, const int *x, int m)
+	{
+		int borrow = 0;
+		int i = 0;
+		for (; i < m; ++i)
+		{
+			int cur = r[i] - x[i] - borrow;
+			borrow = cur < 0;
+			r[i] = borrow ? cur + INF : cur;
+		}
+		for (; borrow && (i < n); ++i)
+		{
+			borrow = (--r[i] < 0);
+			if (borrow)
+				r[i] += INF;
+		}
+		return borrow;
+	}
+
+	// r[0 .. n) = x[0 .. n) - r[0 .. n) for x >= r
+	static void subLimbsFrom(int *r, const int *x, int n)
+	{
+		int borrow = 0;
+		for (int i = 0; i < n; ++i)
+		{
+			int cur = x[i] - r[i] - borrow;
+			borrow = cur < 0;
+			r[i] = borrow ? cur + INF : cur;
+		}
+	}
+
+	// res[0 .. n + m) = x[0 .. n) * y[0 .. m)
+	static void mulSchoolbook(const int *x, int n, const int *y, int m, int *res)
+	{
+		std::fill_n(res, n + m, 0);
+		for (int i = 0; i < n; ++i)
+		{
+			long long t = x[i], carry = 0;
+			if (!t)
+				continue;
+			for (int j = 0; j < m; ++j)
+			{
+				long long cur = res[i + j] + t * y[j] + carry;
+				res[i + j] = cur % INF;
+				carry = cur / INF;
+			}
+			res[i + m] = carry;
+		}
+	}
+
+	// res[0 .. 2n) = x[0 .. n)^2: every cross product is computed once and
+	// doubled, which saves almost half of the limb products
+	static void sqrSchoolbook(const int *x, int n, int *res)
+	{
+		std::fill_n(res, 2 * n, 0);
+		for (int i = 0; i < n; ++i)
+		{
+			long long t = x[i], carry = 0;
+			if (!t)
+				continue;
+			for (int j = i + 1; j < n; ++j)
+			{
+				long long cur = res[i + j] + t * x[j] + carry;
+				res[i + j] = cur % INF;
+				carry = cur / INF;
+			}
+			res[i + n] = carry;
+		}
+		long long carry = 0;
+		for (int i = 0; i < n; ++i)
+		{
+			long long cur = 2ll * res[2 * i] + 1ll * x[i] * x[i] + carry;
+			res[2 * i] = cur % INF;
+			cur = 2ll * res[2 * i + 1] + cur / INF;
+			res[2 * i + 1] = cur % INF;
+			carry = cur / INF;
+		}
+	}
+
+	// x *= y[0 .. m) without a second buffer: limbs of x are consumed from the
+	// top, so every limb that is still to be read lies below the written part
+	static void mulSchoolbookInPlace(Limbs &x, const int *y, int m)
+	{
+		int n = x.size();
+		x.resize(n + m, 0);
+		for (int i = n - 1; i >= 0; --i)
+		{
+			long long t = x[i], carry = 0;
+			x[i] = 0;
+			if (!t)
+				continue;
+			for (int j = 0; j < m; ++j)
+			{
+				long long cur = x[i + j] + t * y[j] + carry;
+				x[i + j] = cur % INF;
+				carry = cur / INF;
+			}
+			for (int k = i + m; carry; ++k)
+			{
+				long long cur = x[k] + carry;
+				x[k] = cur % INF;
+				carry = cur / INF;
+			}
+		}
+	}
+
+	// res[0 .. 2n) = x[0 .. n) * y[0 .. n)
+	static void mulKaratsuba(const int *x, const int *y, int n, int *res)
+	{
+		// a square stays a square in all three recursive products
+		bool square = (x == y);
+		if (n <= std::max(thresholds().karatsuba, 3))
+		{
+			if (square)
+				sqrSchoolbook(x, n, res);
+			else
+				mulSchoolbook(x, n, y, n, res);
+			return;
+		}
+		int low = n / 2, high = n - low;
+		mulKaratsuba(x, y, low, res);
+		mulKaratsuba(x + low, y + low, high, res + 2 * low);
+		ScratchArena::Buffer < int > buf(4 * (high + 1));
+		std::fill_n(buf.data(), 4 * (high + 1), 0);
+		int *sx = buf.data(), *sy = sx + high + 1, *mid = sy + high + 1;
+		std::copy_n(x + low, high, sx);
+		addLimbs(sx, high + 1, x, low);
+		if (square)
+			sy = sx;
+		else
+		{
+			std::copy_n(y + low, high, sy);
+			addLimbs(sy, high + 1, y, low);
+		}
+		mulKaratsuba(sx, sy, high + 1, mid);
+		int len = 2 * (high + 1);
+		subLimbs(mid, len, res, 2 * low);
+		subLimbs(mid, len, res + 2 * low, 2 * high);
+		while ((len > 0) && (mid[len - 1] == 0))
+			--len;
+		addLimbs(res + low, 2 * n - low, mid, len);
+	}
+
+	// res[0 .. 2n) = x[0 .. n) * y[0 .. n), Toom-3 with the evaluation points
+	// 0, 1, -1, -2, inf and Bodrato's interpolation sequence
+	static void mulToom3(const int *x, const int *y, int n, int *res)
+	{
+		// for a square every product below is a value times itself, which
+		// *= hands on to the squaring kernels
+		bool square = (x == y);
+		int k = (n + 2) / 3;
+		BigInteger x0 = fromLimbs(x, k), x1 = fromLimbs(x + k, k), x2 = fromLimbs(x + 2 * k, n - 2 * k);
+		BigInteger y0 = fromLimbs(y, k), y1 = fromLimbs(y + k, k), y2 = fromLimbs(y + 2 * k, n - 2 * k);
+
+		BigInteger px = x0, py = y0;
+		px += x2, py += y2;
+		BigInteger r1 = px, t = py;
+		r1 += x1, t += y1;
+		r1 *= square ? r1 : t;
+		px -= x1, py -= y1;
+		BigInteger rm1 = px;
+		rm1 *= square ? rm1 : py;
+		px += x2, py += y2;
+		px += px, py += py;
+		px -= x0, py -= y0;
+		BigInteger rm2 = px;
+		rm2 *= square ? rm2 : py;
+		BigInteger r0 = x0;
+		r0 *= square ? r0 : y0;
+		BigInteger r4 = x2;
+		r4 *= square ? r4 : y2;
+
+		BigInteger r3 = rm2;
+		r3 -= r1;
+		r3.divSmall(3);
+		r1 -= rm1;
+		r1.divSmall(2);
+		BigInteger r2 = rm1;
+		r2 -= r0;
+		t = r2;
+		t -= r3;
+		t.divSmall(2);
+		r3 = t;
+		r3 += r4;
+		r3 += r4;
+		r2 += r1;
+		r2 -= r4;
+		r1 -= r3;
+
+		std::fill_n(res, 2 * n, 0);
+		const BigInteger *parts[5] = { &r0, &r1, &r2, &r3, &r4 };
+		for (int i = 0; i < 5; ++i)
+		{
+			const Limbs &p = parts[i]->a;
+			int len = p.size();
+			if ((len == 1) && (p[0] == 0))
+				continue;
+			addLimbs(res + i * k, 2 * n - i * k, p.data(), len);
+		}
+	}
+
+	static unsigned powMod(unsigned long long b, unsigned long long e, unsigned mod)
+	{
+		unsigned long long res = 1;
+		for (b %= mod; e; e >>= 1, b = b * b % mod)
+			if (e & 1)
+				res = res * b % mod;
+		return res;
+	}
+
+	// in-place number-theoretic transform of length n (a power of two) modulo
+	// a prime of the form c * 2^k + 1 with primitive root 3
+	static void ntt(unsigned *f, int n, bool invert, unsigned mod)
+	{
+		for (int i = 1, j = 0; i < n; ++i)
+		{
+			int bit = n >> 1;
+			for (; j & bit; bit >>= 1)
+				j ^= bit;
+			j ^= bit;
+			if (i < j)
+				std::swap(f[i], f[j]);
+		}
+		ScratchArena::Buffer < unsigned > w(n / 2 + 1);
+		for (int len = 2; len <= n; len <<= 1)
+		{
+			unsigned long long root = powMod(3, (mod - 1) / len, mod);
+			if (invert)
+				root = powMod(root, mod - 2, mod);
+			int half = len >> 1;
+			w[0] = 1;
+			for (int i = 1; i < half; ++i)
+				w[i] = w[i - 1] * root % mod;
+			for (int i = 0; i < n; i += len)
+				for (int j = 0; j < half; ++j)
+				{
+					unsigned u = f[i + j];
+					unsigned v = 1ull * f[i + j + half] * w[j] % mod;
+					f[i + j] = (u + v >= mod) ? u + v - mod : u + v;
+					f[i + j + half] = (u >= v) ? u - v : u + mod - v;
+				}
+		}
+		if (invert)
+		{
+			unsigned long long inv = powMod(n, mod - 2, mod);
+			for (int i = 0; i < n; ++i)
+				f[i] = f[i] * inv % mod;
+		}
+	}
+
+	// res[0 .. n + m) = x[0 .. n) * y[0 .. m) as a convolution modulo three
+	// primes, recombined exactly by Garner's CRT; x == y squares and reuses
+	// the forward transform
+	static void mulNTT(const int *x, int n, const int *y, int m, int *res)
+	{
+		static const unsigned MOD[3] = { 998244353, 167772161, 469762049 };
+		bool square = (x == y) && (n == m);
+		int size = 1;
+		while (size < n + m)
+			size <<= 1;
+		ScratchArena::Buffer < unsigned > buf((square ? 3 : 4) * size);
+		unsigned *conv[3] = { buf.data(), buf.data() + size, buf.data() + 2 * size };
+		unsigned *fy = buf.data() + 3 * size;
+		for (int p = 0; p < 3; ++p)
+		{
+			unsigned *fx = conv[p];
+			std::fill_n(fx, size, 0);
+			for (int i = 0; i < n; ++i)
+				fx[i] = x[i] % MOD[p];
+			ntt(fx, size, false, MOD[p]);
+			if (square)
+				for (int i = 0; i < size; ++i)
+					fx[i] = 1ull * fx[i] * fx[i] % MOD[p];
+			else
+			{
+				std::fill_n(fy, size, 0);
+				for (int i = 0; i < m; ++i)
+					fy[i] = y[i] % MOD[p];
+				ntt(fy, size, false, MOD[p]);
+				for (int i = 0; i < size; ++i)
+					fx[i] = 1ull * fx[i] * fy[i] % MOD[p];
+			}
+			ntt(fx, size, true, MOD[p]);
+		}
+
+		const long long p0 = MOD[0], p1 = MOD[1], p2 = MOD[2];
+		const long long inv01 = powMod(p0, p1 - 2, p1);
+		const long long inv012 = powMod(p0 * p1 % p2, p2 - 2, p2);
+		const long long p01_low = p0 * p1 % INF, p01_high = p0 * p1 / INF;
+		long long carry = 0;
+		for (int i = 0; i < n + m; ++i)
+		{
+			long long a0 = conv[0][i];
+			long long a1 = (conv[1][i] - a0 % p1 + p1) % p1 * inv01 % p1;
+			long long a2 = ((conv[2][i] - (a0 + a1 * p0) % p2) % p2 + p2) % p2 * inv012 % p2;
+			long long t1 = a1 * p0, t2 = a2 * p01_low;
+			long long cur = a0 + t1 % INF + t2 % INF + carry % INF;
+			res[i] = cur % INF;
+			carry = cur / INF + t1 / INF + t2 / INF + a2 * p01_high + carry / INF;
+		}
+	}
 
-const std::string tostr(int x, const int k)
-{
-	std::string cur_s;
-	for (int j = 0; (j < k) || (x > 0); j++)
+	// res[0 .. n + m) = x[0 .. n) * y[0 .. m), dispatched on operand sizes
+	static void mulLimbs(const int *x, int n, const int *y, int m, int *res)
 	{
-		int rem = x % 10;
-		cur_s += ('0' + rem);
-		x /= 10;
+		if (n < m)
+		{
+			std::swap(x, y);
+			std::swap(n, m);
+		}
+		if (m <= thresholds().karatsuba)
+		{
+			if ((x == y) && (n == m))
+				sqrSchoolbook(x, n, res);
+			else
+				mulSchoolbook(x, n, y, m, res);
+			return;
+		}
+		if ((m >= thresholds().ntt) && (n + m <= (1 << NTT_MAX_LOG)))
+		{
+			mulNTT(x, n, y, m, res);
+			return;
+		}
+		if (n >= 2 * m)
+		{
+			std::fill_n(res, n + m, 0);
+			ScratchArena::Buffer < int > cur(2 * m);
+			for (int off = 0; off < n; off += m)
+			{
+				int len = std::min(m, n - off);
+				mulLimbs(x + off, len, y, m, cur.data());
+				addLimbs(res + off, n + m - off, cur.data(), len + m);
+			}
+			return;
+		}
+		// y zero-padded to n limbs and the 2n-limb product, when m < n
+		ScratchArena::Buffer < int > pad(n != m ? 3 * n : 0);
+		int *out = res;
+		if (n != m)
+		{
+			std::fill_n(pad.data(), n, 0);
+			std::copy_n(y, m, pad.data());
+			y = pad.data();
+			out = pad.data() + n;
+		}
+		if (n < std::max(thresholds().toom3, 3))
+			mulKaratsuba(x, y, n, out);
+		else
+			mulToom3(x, y, n, out);
+		if (n != m)
+			std::copy_n(out, n + m, res);
 	}
-	ReverseString(cur_s);
-	return cur_s;
-}
-
-class BigInteger
-{
-private:
-	const int K = 9;
-	const int INF = 1e9;
-	std::vector < int > a;
-	bool minus;
 
-	int min(int x, int y)
+	static int compareLimbs(const int *x, int n, const int *y, int m)
 	{
-		if (x < y)
-			return x;
-		return y;
+		if (n != m)
+			return n < m ? -1 : 1;
+		for (int i = n - 1; i >= 0; --i)
+			if (x[i] != y[i])
+				return x[i] < y[i] ? -1 : 1;
+		return 0;
 	}
 
-	int max(int x, int y)
+	void shiftLeftLimbs(int k)
 	{
-		if (x > y)
-			return x;
-		return y;
+		if ((k > 0) && *this)
+			a.insert(a.begin(), k, 0);
 	}
 
-	void ReverseVector(std::vector < int > &s)
+	void shiftRightLimbs(int k)
 	{
-		std::vector < int > s1 = s;
-		for (int i = 1; i <= (int)s1.size(); ++i)
-			s[i - 1] = s1[s1.size() - i];
+		if (k >= (int)a.size())
+			a.assign(1, 0);
+		else
+			a.erase(a.begin(), a.begin() + k);
+		removeLeadingZeros();
 	}
 
-	BigInteger &sum(BigInteger &x, const BigInteger &y, char sign)
+	// q[0 .. n - m] = u / v and r[0 .. m) = u % v for m >= 2 and v[m - 1] != 0,
+	// Knuth's algorithm D
+	static void divKnuth(const int *u, int n, const int *v, int m, int *q, int *r)
 	{
-		bool ans_minus = false;
-		BigInteger _y = y;
-		_y.minus = !y.minus;
-		if (((sign == '-') && (x < y)) || ((sign == '+') && (x < _y)))
-			ans_minus = true;
-		int z = 0;
-		for (int i = 0; i < max(x.a.size(), y.a.size()); ++i)
+		long long d = INF / (v[m - 1] + 1);
+		ScratchArena::Buffer < int > un(n + 1), vn(m);
+		long long carry = 0;
+		for (int i = 0; i < n; ++i)
 		{
-			int cur = 0, x1 = 0, x2 = 0;
-			if (i < (int)x.a.size())
-				x1 = (x.minus ? -1 : 1) * x.a[i];
-			if (i < (int)y.a.size())
-				x2 = (y.minus ? -1 : 1) * y.a[i];
-			cur = z + x1 + (sign == '-' ? -x2 : x2);
-			if (i < (int)x.a.size())
-				x.a[i] = cur % INF;
-			else
-				x.a.push_back(cur % INF);
-			z = cur / INF;
+			long long cur = u[i] * d + carry;
+			un[i] = cur % INF;
+			carry = cur / INF;
 		}
-		if (z != 0)
-			x.a.push_back(z);
-		x.minus = ans_minus;
-		if (x.minus)
-			for (int i = 0; i < (int)x.a.size(); ++i)
+		un[n] = carry;
+		carry = 0;
+		for (int i = 0; i < m; ++i)
+		{
+			long long cur = v[i] * d + carry;
+			vn[i] = cur % INF;
+			carry = cur / INF;
+		}
+		for (int j = n - m; j >= 0; --j)
+		{
+			long long num = 1ll * un[j + m] * INF + un[j + m - 1];
+			long long qhat = num / vn[m - 1], rhat = num % vn[m - 1];
+			while ((qhat >= INF) || (qhat * vn[m - 2] > rhat * INF + un[j + m - 2]))
 			{
-				if (x.a[i] > 0)
-				{
-					x.a[i] -= INF;
-					x.a[i + 1] += 1;
-				}
+				--qhat;
+				rhat += vn[m - 1];
+				if (rhat >= INF)
+					break;
 			}
-		else
-			for (int i = 0; i < (int)x.a.size(); ++i)
+			long long borrow = 0;
+			carry = 0;
+			for (int i = 0; i < m; ++i)
 			{
-				if (x.a[i] < 0)
-				{
-					x.a[i] += INF;
-					x.a[i + 1] -= 1;
-				}
+				long long p = qhat * vn[i] + carry;
+				carry = p / INF;
+				long long cur = un[i + j] - p % INF - borrow;
+				borrow = cur < 0;
+				un[i + j] = borrow ? cur + INF : cur;
 			}
-		for (int i = 0; i < (int)x.a.size(); ++i)
-			if (x.a[i] < 0)
-				x.a[i] = -x.a[i];
-		while ((x.a.size() > 1) && (x.a.back() == 0))
-			a.pop_back();
+			long long top = un[j + m] - carry - borrow;
+			if (top < 0)
+			{
+				--qhat;
+				top += addLimbs(un.data() + j, m, vn.data(), m);
+			}
+			un[j + m] = top;
+			q[j] = qhat;
+		}
+		long long rem = 0;
+		for (int i = m - 1; i >= 0; --i)
+		{
+			long long cur = un[i] + rem * INF;
+			r[i] = cur / d;
+			rem = cur % d;
+		}
+	}
+
+	static BigInteger powerOfBase(int k)
+	{
+		BigInteger res = 1;
+		res.shiftLeftLimbs(k);
+		return res;
+	}
+
+	// floor(B^(2k) / v) for a k-limb v, by Newton iteration that doubles the
+	// number of correct limbs on every level of the recursion; the half-size
+	// reciprocal keeps two guard limbs, so the fix-up loops run O(1) times
+	static BigInteger reciprocal(const BigInteger &v)
+	{
+		int k = v.a.size();
+		if (k < std::max(thresholds().newton, 8))
+		{
+			BigInteger q, r;
+			divModKnuth(powerOfBase(2 * k), v, q, r);
+			return q;
+		}
+		int h = (k + 1) / 2 + 2;
+		BigInteger x = reciprocal(fromLimbs(v.a.data() + k - h, h));
+		x.shiftLeftLimbs(k - h);
+		BigInteger e = powerOfBase(2 * k), t = v;
+		t *= x;
+		e -= t;
+		e *= x;
+		e.shiftRightLimbs(2 * k);
+		x += e;
+		BigInteger r = powerOfBase(2 * k);
+		t = v;
+		t *= x;
+		r -= t;
+		while (r.minus)
+		{
+			--x;
+			r += v;
+		}
+		while (r >= v)
+		{
+			++x;
+			r -= v;
+		}
 		return x;
 	}
 
-	BigInteger mult(const BigInteger &x, const int &y, int n)
+	// u / v through the reciprocal of v; both are scaled by s limbs so that
+	// the dividend has at most twice the limbs of the divisor
+	static void divNewton(const BigInteger &u, const BigInteger &v, BigInteger &q, BigInteger &r)
 	{
-		long long z = 0;
-		BigInteger res;
-		res.a.clear();
+		int n = u.a.size(), m = v.a.size();
+		int s = std::max(0, n - 2 * m);
+		BigInteger vs = v;
+		vs.shiftLeftLimbs(s);
+		BigInteger x = reciprocal(vs);
+		q = u;
+		q.shiftLeftLimbs(s);
+		q *= x;
+		q.shiftRightLimbs(2 * (m + s));
+		BigInteger t = q;
+		t *= v;
+		r = u;
+		r -= t;
+		while (r.minus)
+		{
+			--q;
+			r += v;
+		}
+		while (r >= v)
+		{
+			++q;
+			r -= v;
+		}
+	}
+
+	// |x| / |y| for |x| >= |y| and a divisor of at least two limbs
+	static void divModKnuth(const BigInteger &x, const BigInteger &y, BigInteger &q, BigInteger &r)
+	{
+		int n = x.a.size(), m = y.a.size();
+		Limbs quot, rem;
+		quot.resize(n - m + 1);
+		rem.resize(m);
+		divKnuth(x.a.data(), n, y.a.data(), m, quot.data(), rem.data());
+		q.a.swap(quot);
+		q.minus = false;
+		q.removeLeadingZeros();
+		r.a.swap(rem);
+		r.minus = false;
+		r.removeLeadingZeros();
+	}
+
+	// q = |x| / |y| and r = |x| % |y| as non-negative values; q and r may
+	// alias x or y
+	static void divModMagnitude(const BigInteger &x, const BigInteger &y, BigInteger &q, BigInteger &r)
+	{
+		int n = x.a.size(), m = y.a.size();
+		if (compareLimbs(x.a.data(), n, y.a.data(), m) < 0)
+		{
+			r = x;
+			r.minus = false;
+			q = 0;
+			return;
+		}
+		if (m == 1)
+		{
+			int d = y.a[0];
+			q = x;
+			q.minus = false;
+			r = q.divSmall(d);
+			return;
+		}
+		if ((m >= thresholds().newton) && (n - m >= thresholds().newton))
+		{
+			BigInteger u = x, v = y;
+			u.minus = v.minus = false;
+			divNewton(u, v, q, r);
+			return;
+		}
+		divModKnuth(x, y, q, r);
+	}
+
+	// (x, y) = (p * x + q * y, r * x + s * y) for non-negative results, with
+	// the cofactors below 10^9 in absolute value; one pass over the limbs
+	static void combineLimbs(BigInteger &x, BigInteger &y, long long p, long long q, long long r, long long s)
+	{
+		int n = std::max(x.a.size(), y.a.size());
+		x.a.resize(n, 0);
+		y.a.resize(n, 0);
+		long long cx = 0, cy = 0;
 		for (int i = 0; i < n; ++i)
-			res.a.push_back(0);
-		for (int i = 0; i < (int)x.a.size(); ++i)
 		{
-			long long cur = z + 1ll * x.a[i] * y;
-			res.a.push_back(cur % INF);
-			z = cur / INF;
+			long long xi = x.a[i], yi = y.a[i];
+			long long nx = p * xi + q * yi + cx, ny = r * xi + s * yi + cy;
+			cx = nx / INF - (nx % INF < 0);
+			cy = ny / INF - (ny % INF < 0);
+			x.a[i] = nx - cx * INF;
+			y.a[i] = ny - cy * INF;
 		}
-		if (z != 0)
-			res.a.push_back(z);
-		while ((res.a.size() > 1) && (res.a.back() == 0))
-			res.a.pop_back();
-		return res;
+		x.removeLeadingZeros();
+		y.removeLeadingZeros();
 	}
 
-	std::string mult(std::string s, int x)
+	BigInteger &fusedMul(const BigInteger &x, const BigInteger &y, bool subtract)
 	{
-		std::string res;
-		int rem = 0;
-		for (int i = s.size() - 1; i >= 0; --i)
+		bool product_minus = (x.minus != y.minus) != subtract;
+		int n = x.a.size(), m = y.a.size();
+		bool zero = (a.size() == 1) && (a[0] == 0);
+		if ((this == &x) || (this == &y) || (!zero && (minus != product_minus)) || (std::min(n, m) > thresholds().karatsuba))
 		{
-			int k = (s[i] - '0') * x + rem;
-			res += (k % 10 + '0');
-			rem = k / 10;
+			BigInteger p = x;
+			p *= y;
+			return subtract ? (*this -= p) : (*this += p);
 		}
-		if (rem)
-			res += (rem + '0');
-		ReverseString(res);
-		return res;
+		a.resize(std::max((int)a.size(), n + m) + 1, 0);
+		for (int i = 0; i < n; ++i)
+		{
+			long long t = x.a[i], carry = 0;
+			if (!t)
+				continue;
+			for (int j = 0; j < m; ++j)
+			{
+				long long cur = a[i + j] + t * y.a[j] + carry;
+				a[i + j] = cur % INF;
+				carry = cur / INF;
+			}
+			for (int k = i + m; carry; ++k)
+			{
+				long long cur = a[k] + carry;
+				a[k] = cur % INF;
+				carry = cur / INF;
+			}
+		}
+		minus = product_minus;
+		removeLeadingZeros();
+		return *this;
 	}
 
-	bool less(std::string &x, std::string &y)
+	// divides the magnitude by a small d in place, returns the remainder
+	int divSmall(int d)
 	{
-		if (x.size() < y.size())
-			return true;
-		if (x.size() > y.size())
-			return false;
-		for (int i = 0; i < (int)x.size(); ++i)
+		long long rem = 0;
+		for (int i = a.size() - 1; i >= 0; --i)
 		{
-			if (x[i] < y[i])
-				return true;
-			if (x[i] > y[i])
+			long long cur = a[i] + rem * INF;
+			a[i] = cur / d;
+			rem = cur % d;
+		}
+		removeLeadingZeros();
+		return rem;
+	}
+
+	// the 4- and 8-byte little-endian fields of the binary forms, spelled
+	// out byte by byte so that compilers emit single loads and stores
+	static unsigned readWord(const unsigned char *p)
+	{
+		return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned)p[3] << 24);
+	}
+
+	static unsigned long long readDoubleWord(const unsigned char *p)
+	{
+		return readWord(p) | ((unsigned long long)readWord(p + 4) << 32);
+	}
+
+	static void writeWord(unsigned char *p, unsigned x)
+	{
+		p[0] = x;
+		p[1] = x >> 8;
+		p[2] = x >> 16;
+		p[3] = x >> 24;
+	}
+
+	static void writeDoubleWord(unsigned char *p, unsigned long long x)
+	{
+		writeWord(p, x);
+		writeWord(p + 4, x >> 32);
+	}
+
+	// whether n 4-byte limbs at p, low first, form a value in normal form:
+	// every limb below 10^9, no leading zero limb and no negative zero
+	static bool validLimbs(const unsigned char *p, size_t n, bool negative)
+	{
+		for (size_t i = 0; i < n; ++i)
+			if (readWord(p + 4 * i) >= (unsigned)INF)
 				return false;
+		unsigned top = readWord(p + 4 * (n - 1));
+		return top || ((n == 1) && !negative);
+	}
+
+	// decodes the varint of limbs() * 2 + sign that follows the version byte;
+	// returns the end of it, or nullptr if [first, last) is too short for it
+	// or it does not fit in 64 bits
+	static const unsigned char *readHeader(const unsigned char *first, const unsigned char *last, unsigned long long &header)
+	{
+		header = 0;
+		for (int shift = 0; first != last; shift += 7)
+		{
+			unsigned long long c = *first++;
+			if ((shift > 63) || ((shift == 63) && (c > 1)))
+				return nullptr;
+			header |= (c & 0x7F) << shift;
+			if (!(c & 0x80))
+				return first;
 		}
-		return false;
+		return nullptr;
 	}
 
 public:
+	// operand sizes in limbs at which multiplication switches from the
+	// schoolbook kernel to Karatsuba, from Karatsuba to Toom-3 and from
+	// Toom-3 to the NTT, and at which division switches from Knuth's
+	// algorithm D to Newton reciprocal division
+	struct Thresholds
+	{
+		int karatsuba;
+		int toom3;
+		int ntt;
+		int newton;
+		// limbs in a product or sum subtree before it gets its own thread
+		int parallel;
+	};
+
+	static Thresholds &thresholds()
+	{
+		static Thresholds t = { 32, 200, 1000, 2500, 20000 };
+		return t;
+	}
+
+	// sums many values with the carries deferred: every limb position is a
+	// 64-bit lane, so adding a value is one branch-free loop the compiler
+	// vectorises (AVX2 where enabled), and lanes are normalised only in
+	// result() or when they could overflow
+	class Accumulator
+	{
+	public:
+		Accumulator()
+			: count_(0)
+		{}
+
+		Accumulator &operator+=(const BigInteger &x)
+		{
+			add(x, x.minus);
+			return *this;
+		}
+
+		Accumulator &operator-=(const BigInteger &x)
+		{
+			add(x, !x.minus);
+			return *this;
+		}
+
+		BigInteger result() const
+		{
+			BigInteger res = fromLanes(lanes_[0]);
+			res -= fromLanes(lanes_[1]);
+			return res;
+		}
+
+	private:
+		// additions of limbs below 10^9 that a 64-bit lane takes safely
+		static const long long LIMIT = 1ll << 33;
+
+		void add(const BigInteger &x, bool negative)
+		{
+			std::vector < unsigned long long > &lanes = lanes_[negative];
+			int n = x.a.size();
+			if ((int)lanes.size() < n)
+				lanes.resize(n, 0);
+			const int *p = x.a.data();
+			unsigned long long *q = lanes.data();
+			for (int i = 0; i < n; ++i)
+				q[i] += p[i];
+			if (++count_ == LIMIT)
+			{
+				normalise(lanes_[0]);
+				normalise(lanes_[1]);
+				count_ = 0;
+			}
+		}
+
+		static void normalise(std::vector < unsigned long long > &lanes)
+		{
+			unsigned long long carry = 0;
+			for (size_t i = 0; i < lanes.size(); ++i)
+			{
+				unsigned long long cur = lanes[i] + carry;
+				lanes[i] = cur % INF;
+				carry = cur / INF;
+			}
+			for (; carry; carry /= INF)
+				lanes.push_back(carry % INF);
+		}
+
+		static BigInteger fromLanes(std::vector < unsigned long long > lanes)
+		{
+			normalise(lanes);
+			BigInteger res;
+			res.a.resize(std::max((size_t)1, lanes.size()), 0);
+			std::copy(lanes.begin(), lanes.end(), res.a.begin());
+			res.removeLeadingZeros();
+			return res;
+		}
+
+		std::vector < unsigned long long > lanes_[2];
+		long long count_;
+	};
+
+	// greatest common divisor of |x| and |y| by Lehmer's algorithm: the two
+	// leading limbs run a word-sized Euclid that only tracks cofactors, and
+	// the cofactors are applied to the full numbers in one linear pass, so a
+	// full division is needed only when the quotient sequence is ambiguous
+	static BigInteger gcd(BigInteger x, BigInteger y)
+	{
+		x.minus = y.minus = false;
+		if (x < y)
+			std::swap(x, y);
+		while (y.a.size() > 2)
+		{
+			int n = x.a.size();
+			if ((int)y.a.size() < n - 1)
+			{
+				x %= y;
+				std::swap(x, y);
+				continue;
+			}
+			long long xh = 1ll * x.a[n - 1] * INF + x.a[n - 2];
+			long long yh = ((int)y.a.size() == n ? 1ll * y.a[n - 1] * INF : 0) + y.a[n - 2];
+			long long p = 1, q = 0, r = 0, s = 1;
+			while ((yh + r != 0) && (yh + s != 0))
+			{
+				long long q1 = (xh + p) / (yh + r), q2 = (xh + q) / (yh + s);
+				if ((q1 != q2) || (q1 >= INF))
+					break;
+				long long t = p - q1 * r;
+				p = r;
+				r = t;
+				t = q - q1 * s;
+				q = s;
+				s = t;
+				t = xh - q1 * yh;
+				xh = yh;
+				yh = t;
+				if ((std::abs(r) >= INF / 2) || (std::abs(s) >= INF / 2))
+					break;
+			}
+			if (q == 0)
+			{
+				x %= y;
+				std::swap(x, y);
+			}
+			else
+				combineLimbs(x, y, p, q, r, s);
+		}
+		if (!y)
+			return x;
+		x %= y;
+		long long u = y.a[0] + (y.a.size() > 1 ? 1ll * y.a[1] * INF : 0);
+		long long v = x.a[0] + (x.a.size() > 1 ? 1ll * x.a[1] * INF : 0);
+		while (v)
+		{
+			long long t = u % v;
+			u = v;
+			v = t;
+		}
+		BigInteger res;
+		res.a.assign(1, u % INF);
+		if (u >= INF)
+			res.a.push_back(u / INF);
+		return res;
+	}
+
+	// x^e by left-to-right binary exponentiation; every x *= x runs on the
+	// squaring kernels
+	static BigInteger pow(const BigInteger &x, unsigned e)
+	{
+		if (!e)
+			return 1;
+		int top = 31;
+		while (!((e >> top) & 1))
+			--top;
+		BigInteger res = x;
+		for (int i = top - 1; i >= 0; --i)
+		{
+			res *= res;
+			if ((e >> i) & 1)
+				res *= x;
+		}
+		return res;
+	}
+
+	// floor(sqrt(x)) for x >= 0
+	static BigInteger isqrt(const BigInteger &x)
+	{
+		return iroot(x, 2);
+	}
+
+	// the k-th root of x rounded towards zero, k >= 1; 0 for a negative x and
+	// an even k. The root of the leading half of the limbs, plus one and
+	// shifted back, is an upper bound that Newton's iteration
+	// s = ((k - 1) s + x / s^(k - 1)) / k brings down to the exact root in a
+	// couple of steps, so only the last level of the recursion works with
+	// full-size numbers
+	static BigInteger iroot(const BigInteger &x, int k)
+	{
+		if (x.minus)
+			return k % 2 ? -iroot(-x, k) : 0;
+		if ((k == 1) || !x)
+			return x;
+		int n = x.a.size();
+		int h = (n - 1) / (2 * k);
+		BigInteger s;
+		if (h)
+		{
+			BigInteger top = x;
+			top.shiftRightLimbs(k * h);
+			s = iroot(top, k);
+			++s;
+			s.shiftLeftLimbs(h);
+		}
+		else
+		{
+			// the root has at most two limbs: start just above a floating
+			// point estimate taken from the leading limbs
+			double lead = x.a[n - 1] + (n > 1 ? x.a[n - 2] / (double)INF : 0);
+			double estimate = std::pow(10.0, (std::log10(lead) + K * (n - 1.0)) / k);
+			if (estimate < 1.5)
+				return 1;
+			estimate = estimate * (1 + 1e-9) + 2;
+			s = (int)(estimate / INF);
+			s *= INF;
+			s += (int)std::fmod(estimate, (double)INF);
+		}
+		while (true)
+		{
+			BigInteger t = x;
+			t /= pow(s, k - 1);
+			BigInteger u = s;
+			u *= k - 1;
+			t += u;
+			t /= k;
+			if (t >= s)
+				return s;
+			s = std::move(t);
+		}
+	}
+
+	// modular arithmetic for a fixed modulus, defined after the class
+	class ModContext;
+
+	// number of base 10^9 limbs
+	size_t limbs() const
+	{
+		return a.size();
+	}
+
+	// number of decimal digits of |x|; 1 for zero
+	size_t digits() const
+	{
+		size_t res = (a.size() - 1) * K;
+		for (int x = a.back(); x; x /= 10)
+			++res;
+		return std::max(res, (size_t)1);
+	}
+
+	// x ~ m * leadingBase()^e from the top three limbs, with 1 <= |m| < 10^9
+	// of the sign of x (0 for zero) and a relative error of a few ulps, so
+	// values that differ in their leading digits compare without products
+	double leading(int &e) const
+	{
+		int n = a.size();
+		e = n - 1;
+		double m = a[n - 1];
+		if (n > 1)
+			m += (a[n - 2] + (n > 2 ? a[n - 3] * (1.0 / INF) : 0.0)) * (1.0 / INF);
+		return minus ? -m : m;
+	}
+
+	static double leadingBase()
+	{
+		return INF;
+	}
 
 	BigInteger(const BigInteger &other)
 		: a(other.a)
 		, minus(other.minus)
 	{}
 
+	BigInteger(BigInteger &&other) noexcept
+		: a(std::move(other.a))
+		, minus(other.minus)
+	{
+		other.a.assign(1, 0);
+		other.minus = false;
+	}
+
 	BigInteger(int x = 0)
 	{
 		minus = false;
@@ -180,56 +1474,218 @@ public:
 
 	BigInteger(const std::string &s)
 	{
-		int k = 0;
-		a.clear();
-		a.push_back(0);
-		minus = false;
-		if (s[0] == '-')
+		fromChars(s.data(), s.data() + s.size());
+	}
+
+	// parses an optional '-' followed by decimal digits from [first, last);
+	// every limb is read straight from its 9-character slice of the input
+	BigInteger &fromChars(const char *first, const char *last)
+	{
+		minus = (first != last) && (*first == '-');
+		if (minus)
+			++first;
+		int n = last - first;
+		a.assign(std::max(1, (n + K - 1) / K), 0);
+		for (int end = n, i = 0; end > 0; end -= K, ++i)
 		{
-			minus = true;
-			k++;
+			int x = 0;
+			for (int j = std::max(0, end - K); j < end; ++j)
+				x = x * 10 + (first[j] - '0');
+			a[i] = x;
 		}
-		int j = -1, step = 1;
-		for (int i = 0; i < (int)s.size() - k; ++i)
+		removeLeadingZeros();
+		return *this;
+	}
+
+	// upper bound on the number of characters toChars writes
+	size_t decimalLength() const
+	{
+		return a.size() * K + 1;
+	}
+
+	// writes the decimal form to buf without a terminator and returns its
+	// length; buf must hold decimalLength() characters
+	size_t toChars(char *buf) const
+	{
+		char *p = buf;
+		if (minus)
+			*p++ = '-';
+		char top[K];
+		int len = 0;
+		int x = a.back();
+		do
 		{
-			if (!(i % 9))
-			{
-				step = 1;
-				j++;
-			}
-			if (j == (int)a.size())
-				a.push_back(0);
-			a[j] = step * (s[s.size() - i - 1] - '0') + a[j];
-			step *= 10;
+			top[len++] = '0' + x % 10;
+			x /= 10;
+		} while (x);
+		while (len)
+			*p++ = top[--len];
+		for (int i = a.size() - 2; i >= 0; --i, p += K)
+		{
+			x = a[i];
+			for (int j = K - 1; j >= 0; --j, x /= 10)
+				p[j] = '0' + x % 10;
 		}
+		return p - buf;
 	}
 
 	const std::string toString() const
 	{
-		std::string s;
-		if (minus)
-			s += '-';
-		s += tostr(a.back(), 0);
-		for (int i = a.size() - 2; i >= 0; --i)
+		std::string s(decimalLength(), '0');
+		s.resize(toChars(&s[0]));
+		return s;
+	}
+
+	// binary form: a format version byte, a little-endian base 128 varint of
+	// limbs() * 2 + sign, then every limb as 4 little-endian bytes, low limb
+	// first. It is about 2.2 times smaller than the decimal text, and both
+	// directions copy limbs instead of converting them
+	static const unsigned char SERIAL_VERSION = 1;
+
+	// upper bound on the number of bytes serialize writes
+	size_t serializedLength() const
+	{
+		return 11 + 4 * a.size();
+	}
+
+	// writes the binary form to buf and returns its length; buf must hold
+	// serializedLength() bytes
+	size_t serialize(unsigned char *buf) const
+	{
+		unsigned char *p = buf;
+		*p++ = SERIAL_VERSION;
+		unsigned long long header = 2ull * a.size() + minus;
+		for (; header >= 0x80; header >>= 7)
+			*p++ = (header & 0x7F) | 0x80;
+		*p++ = header;
+		for (size_t i = 0; i < a.size(); ++i, p += 4)
+			writeWord(p, a[i]);
+		return p - buf;
+	}
+
+	void serialize(std::ostream &os) const
+	{
+		std::string buf(serializedLength(), '\0');
+		os.write(buf.data(), serialize((unsigned char *)&buf[0]));
+	}
+
+	// reads the binary form from [first, last) and returns the end of it, or
+	// nullptr, leaving the value unchanged, if the input is truncated, of
+	// another version or not a BigInteger in normal form
+	const unsigned char *deserialize(const unsigned char *first, const unsigned char *last)
+	{
+		unsigned long long header = 0;
+		if ((first == last) || (*first != SERIAL_VERSION))
+			return nullptr;
+		first = readHeader(first + 1, last, header);
+		if (!first)
+			return nullptr;
+		unsigned long long n = header >> 1;
+		bool negative = header & 1;
+		if (!n || (n > (unsigned long long)(last - first) / 4) || !validLimbs(first, n, negative))
+			return nullptr;
+		a.assign(n, 0);
+		for (size_t i = 0; i < n; ++i, first += 4)
+			a[i] = readWord(first);
+		minus = negative;
+		return first;
+	}
+
+	// sets failbit, leaving the value unchanged, where the buffer version
+	// would fail; the limbs are read in bounded chunks, so a corrupt length
+	// cannot make it allocate more than the stream holds
+	std::istream &deserialize(std::istream &is)
+	{
+		std::string buf;
+		unsigned long long header = 0;
+		const unsigned char *end = nullptr;
+		for (char c; !end && (buf.size() < 11) && is.get(c); )
 		{
-			s += tostr(a[i], K);
+			buf += c;
+			const unsigned char *p = (const unsigned char *)buf.data();
+			if (buf.size() > 1)
+				end = readHeader(p + 1, p + buf.size(), header);
 		}
-		if (s.empty())
-			s = "0";
-		return s;
+		for (unsigned long long rest = 4 * (header >> 1); end && rest; )
+		{
+			size_t chunk = std::min(rest, 1ull << 16), size = buf.size();
+			buf.resize(size + chunk);
+			if (!is.read(&buf[size], chunk))
+				break;
+			rest -= chunk;
+		}
+		const unsigned char *p = (const unsigned char *)buf.data();
+		if (!end || !deserialize(p, p + buf.size()))
+			is.setstate(std::ios::failbit);
+		return is;
+	}
+
+	// array layout for memory mapping, all little-endian with every field
+	// aligned to its size: the 8-byte magic "BIGARR" + '\0' + SERIAL_VERSION,
+	// the count as 8 bytes, count + 1 entries of 8 bytes holding the index
+	// of the value's first limb * 2 + sign (the last one the total number of
+	// limbs * 2), then the limbs as 4-byte words; read back by ArrayView
+	template < class Iterator >
+	static void serializeArray(Iterator first, Iterator last, std::ostream &os)
+	{
+		unsigned char word[8] = { 'B', 'I', 'G', 'A', 'R', 'R', 0, SERIAL_VERSION };
+		os.write((const char *)word, 8);
+		writeDoubleWord(word, std::distance(first, last));
+		os.write((const char *)word, 8);
+		unsigned long long offset = 0;
+		for (Iterator it = first; it != last; ++it)
+		{
+			writeDoubleWord(word, 2 * offset + it->minus);
+			os.write((const char *)word, 8);
+			offset += it->a.size();
+		}
+		writeDoubleWord(word, 2 * offset);
+		os.write((const char *)word, 8);
+		std::string buf;
+		for (Iterator it = first; it != last; ++it)
+		{
+			buf.resize(4 * it->a.size());
+			for (size_t i = 0; i < it->a.size(); ++i)
+				writeWord((unsigned char *)&buf[4 * i], it->a[i]);
+			os.write(buf.data(), buf.size());
+		}
+	}
+
+	// read-only view of the array layout, defined after the class
+	class ArrayView;
+
+	BigInteger& operator=(const BigInteger &b) 
+	{
+		if (this == &b) 
+		{
+			return *this;
+		}
+		a = b.a;
+		minus = b.minus;
+		return *this;
 	}
 
-	BigInteger& operator=(const BigInteger &b) 
+	BigInteger& operator=(BigInteger &&b) noexcept
 	{
-		if (this == &b) 
+		if (this == &b)
 		{
 			return *this;
 		}
-		a = b.a;
+		a = std::move(b.a);
 		minus = b.minus;
+		b.a.assign(1, 0);
+		b.minus = false;
 		return *this;
 	}
 
+	// exchanges the limbs without resetting a moved-from value, for std::sort
+	// and anything else that finds swap by argument-dependent lookup
+	friend void swap(BigInteger &x, BigInteger &y) noexcept
+	{
+		x.a.swap(y.a);
+		std::swap(x.minus, y.minus);
+	}
+
 	bool operator==(const BigInteger &b) const
 	{
 		return (a == b.a) && (minus == b.minus);
@@ -279,11 +1735,25 @@ public:
 	}
 
 
-	explicit operator bool() const {
+	explicit operator bool() const 
+	{
 		return (a.size() != 1) || (a.back() != 0);
 	}
 
-	const BigInteger operator-() const
+	explicit operator double() const
+	{
+		double res = 0;
+		for (int i = a.size() - 1; i >= 0; --i)
+		{
+			res *= INF;
+			res += a[i];
+		}
+		if (minus)
+			res *= -1;
+		return res;
+	}
+
+	BigInteger operator-() const &
 	{
 		if ((a.size() == 1) && (a[0] == 0))
 			return *this;
@@ -295,105 +1765,85 @@ public:
 		return res;
 	}
 
-	const BigInteger operator +() const {
+	BigInteger operator-() &&
+	{
+		if ((a.size() != 1) || (a[0] != 0))
+			minus = !minus;
+		return std::move(*this);
+	}
+
+	BigInteger operator +() const {
 		return *this;
 	}
 
 	BigInteger &operator+=(const BigInteger &b)
 	{
-		*this = sum(*this, b, '+');
+		sum(b, b.minus);
 		return *this;
 	}
 
 	BigInteger &operator-=(const BigInteger &b)
 	{
-		*this = sum(*this, b, '-');
+		sum(b, !b.minus);
 		return *this;
 	}
 
 	BigInteger &operator/=(const BigInteger &b)
 	{
-		BigInteger c = *this, d = b;
-		c.minus = false, d.minus = false;
-		if (c < d)
-		{
-			*this = 0;
-			return *this;
-		}
-		std::string x = c.toString();
-		std::string y = d.toString();
-		std::string ans;
-		for (int k = (int)x.size() - (int)y.size(); k >= 0; --k)
-		{
-			std::string z;
-			for (int j = 0; j < (int)x.size() - k; ++j)
-				if ((!z.empty()) || (x[j] != '0'))
-					z += x[j];
-			if (z.empty())
-				z = "0";
-			if (less(z, y))
-			{
-				if (!ans.empty())
-					ans += '0';
-			}
-			else
-			{
-				int cur = 9;
-				bool f = true;
-				std::string y_cur;
-				while (f)
-				{
-					y_cur = mult(y, cur);
-					if (less(y_cur, z) || (y_cur == z))
-						f = false;
-					else
-						cur--;
-				}
-				ans += ('0' + cur);
-				BigInteger cur_d = BigInteger(z);
-				cur_d -= BigInteger(y_cur);
-				z = cur_d.toString();
-				if (z == "0")
-					z = "";
-				for (int j = (int)x.size() - k; j < (int)x.size(); ++j)
-					if (((int)z.size() != 0) || (x[j] != '0'))
-						z += x[j];
-				x = z;
-				if (x.empty())
-					x = "0";
-			}
-		}
-		if (ans.empty())
-			ans = "0";
-		if ((minus != b.minus) && (ans != "0"))
-			ans = "-" + ans;
-		BigInteger res = ans;
-		*this = res;
+		BigInteger rem;
+		return divmod(b, rem);
+	}
+
+	// *this becomes the quotient and rem the remainder of *this / b, rounded
+	// towards zero like the built-in integer division
+	BigInteger &divmod(const BigInteger &b, BigInteger &rem)
+	{
+		bool q_minus = (minus != b.minus), r_minus = minus;
+		divModMagnitude(*this, b, *this, rem);
+		minus = q_minus;
+		removeLeadingZeros();
+		rem.minus = r_minus;
+		rem.removeLeadingZeros();
 		return *this;
 	}
 
 	BigInteger &operator*=(const BigInteger &b)
 	{
-		BigInteger res;
-		for (int i = 0; i < (int)b.a.size(); ++i)
+		bool res_minus = (minus != b.minus);
+		int n = a.size(), m = b.a.size();
+		// x *= x goes to mulLimbs, which squares
+		if ((this != &b) && (std::min(n, m) <= thresholds().karatsuba))
+			mulSchoolbookInPlace(a, b.a.data(), m);
+		else
 		{
-			BigInteger cur = mult(*this, b.a[i], i);
-			res += cur;
+			Limbs res;
+			res.resize(n + m);
+			mulLimbs(a.data(), n, b.a.data(), m, res.data());
+			a.swap(res);
 		}
-		if (minus != b.minus)
-			res.minus = true;
-		if (((int)res.a.size() == 1) && (res.a[0] == 0))
-			minus = false;
-		*this = res;
+		minus = res_minus;
+		removeLeadingZeros();
 		return *this;
 	}
 
+	// *this += x * y. When the product has the sign of *this and one factor
+	// is short, the schoolbook rows are added straight into the limbs and the
+	// product is never stored on its own
+	BigInteger &addMul(const BigInteger &x, const BigInteger &y)
+	{
+		return fusedMul(x, y, false);
+	}
+
+	// *this -= x * y, fused like addMul
+	BigInteger &subMul(const BigInteger &x, const BigInteger &y)
+	{
+		return fusedMul(x, y, true);
+	}
+
 	BigInteger &operator%=(const BigInteger &b)
 	{
-		BigInteger cur = *this;
-		cur /= b;
-		cur *= b;
-		*this -= cur;
+		BigInteger q = *this;
+		q.divmod(b, *this);
 		return *this;
 	}
 
@@ -425,48 +1875,668 @@ public:
 std::istream &operator>>(std::istream &is, BigInteger &b)
 {
 	std::string s;
-	is >> s;
-	b = s;
+	if (is >> s)
+		b.fromChars(s.data(), s.data() + s.size());
 	return is;
 }
 
 std::ostream &operator<<(std::ostream &os, const BigInteger &b)
 {
-	os << (BigInteger(b)).toString();
+	os << b.toString();
 	return os;
 }
 
-const BigInteger operator+(const BigInteger &x, const BigInteger &y)
+// the results are not const, and an rvalue operand is updated in place and
+// returned, so in a * b + c * d - e only the two products allocate
+BigInteger operator+(const BigInteger &x, const BigInteger &y)
 {
 	BigInteger res = x;
 	res += y;
 	return res;
 }
 
-const BigInteger operator-(const BigInteger &x, const BigInteger &y)
+BigInteger operator+(BigInteger &&x, const BigInteger &y)
+{
+	x += y;
+	return std::move(x);
+}
+
+BigInteger operator+(const BigInteger &x, BigInteger &&y)
+{
+	y += x;
+	return std::move(y);
+}
+
+BigInteger operator+(BigInteger &&x, BigInteger &&y)
+{
+	x += y;
+	return std::move(x);
+}
+
+BigInteger operator-(const BigInteger &x, const BigInteger &y)
 {
 	BigInteger res = x;
 	res -= y;
 	return res;
 }
 
-const BigInteger operator*(const BigInteger &x, const BigInteger &y)
+BigInteger operator-(BigInteger &&x, const BigInteger &y)
+{
+	x -= y;
+	return std::move(x);
+}
+
+BigInteger operator-(const BigInteger &x, BigInteger &&y)
+{
+	y -= x;
+	return -std::move(y);
+}
+
+BigInteger operator-(BigInteger &&x, BigInteger &&y)
+{
+	x -= y;
+	return std::move(x);
+}
+
+BigInteger operator*(const BigInteger &x, const BigInteger &y)
 {
 	BigInteger res = x;
 	res *= y;
 	return res;
 }
 
-const BigInteger operator/(const BigInteger &x, const BigInteger &y)
+BigInteger operator*(BigInteger &&x, const BigInteger &y)
+{
+	x *= y;
+	return std::move(x);
+}
+
+BigInteger operator*(const BigInteger &x, BigInteger &&y)
+{
+	y *= x;
+	return std::move(y);
+}
+
+BigInteger operator*(BigInteger &&x, BigInteger &&y)
+{
+	x *= y;
+	return std::move(x);
+}
+
+BigInteger operator/(const BigInteger &x, const BigInteger &y)
 {
 	BigInteger res = x;
 	res /= y;
 	return res;
 }
 
-const BigInteger operator%(const BigInteger &x, const BigInteger &y)
+BigInteger operator/(BigInteger &&x, const BigInteger &y)
+{
+	x /= y;
+	return std::move(x);
+}
+
+BigInteger operator%(const BigInteger &x, const BigInteger &y)
 {
 	BigInteger res = x;
 	res %= y;
 	return res;
-}
\ No newline at end of file
+}
+
+BigInteger operator%(BigInteger &&x, const BigInteger &y)
+{
+	x %= y;
+	return std::move(x);
+}
+
+std::pair < BigInteger, BigInteger > divmod(const BigInteger &x, const BigInteger &y)
+{
+	std::pair < BigInteger, BigInteger > res(x, 0);
+	res.first.divmod(y, res.second);
+	return res;
+}
+
+// arithmetic modulo a fixed m != 0. Operands are converted once to base
+// 2^32 words, where a word product plus carries fits 64 bits and no step
+// has to divide by 10^9. Odd moduli use Montgomery form x * R mod m with
+// R = 2^(32k) for a k-word m, so a product is reduced by k single-word
+// steps; even moduli use Barrett reduction with floor((R^2 - 1) / m)
+// precomputed. The reduction runs on buffers the context owns, so powMod
+// does not allocate per step and a context must not be shared between
+// threads
+class BigInteger::ModContext
+{
+public:
+	explicit ModContext(const BigInteger &m)
+		: m_(m)
+	{
+		m_.minus = false;
+		m_words_ = toWords(m_);
+		k_ = m_words_.size();
+		montgomery_ = m_words_[0] & 1;
+		std::vector < unsigned > power(2 * k_ + 1, 0);
+		power[2 * k_] = 1;
+		BigInteger r2 = fromWords(power.data(), power.size());
+		if (montgomery_)
+		{
+			// -m^(-1) mod 2^32 by Newton iteration: an odd m is its own
+			// inverse modulo 8, and every step doubles the correct bits
+			unsigned x = m_words_[0];
+			for (int i = 0; i < 4; ++i)
+				x *= 2 - m_words_[0] * x;
+			inv_ = 0u - x;
+			r2 %= m_;
+			r2_ = toWords(r2);
+			r2_.resize(k_, 0);
+		}
+		else
+		{
+			// (R^2 - 1) rather than R^2, so that mu fits k + 1 words even
+			// when m is a power of two
+			--r2;
+			r2 /= m_;
+			mu_ = toWords(r2);
+			mu_.resize(k_ + 1, 0);
+			q_.resize(2 * k_ + 2);
+			r_.resize(2 * k_ + 1);
+		}
+		t_.resize(2 * k_ + 2);
+		u_.resize(k_);
+		v_.resize(k_);
+	}
+
+	const BigInteger &modulus() const
+	{
+		return m_;
+	}
+
+	// x * y mod m in [0, m); the operands go through buffers kept in the
+	// context, so for x and y already in [0, m) the only allocation is the
+	// result's
+	BigInteger mulMod(const BigInteger &x, const BigInteger &y) const
+	{
+		load(x, u_.data());
+		load(y, v_.data());
+		mul(u_.data(), v_.data(), u_.data());
+		// Montgomery gives x * y / R, one more product with R^2 / R fixes it
+		if (montgomery_)
+			mul(u_.data(), r2_.data(), u_.data());
+		return fromWords(u_.data(), k_);
+	}
+
+	// x^e mod m in [0, m) by a left-to-right sliding window over the bits
+	// of e; a negative e raises the inverse of x
+	BigInteger powMod(const BigInteger &x, const BigInteger &e) const
+	{
+		if (e.minus)
+			return powMod(invMod(x), -e);
+		std::vector < unsigned > exponent = toWords(e);
+		int bits = 32 * (exponent.size() - 1);
+		for (unsigned top = exponent.back(); top; top >>= 1)
+			++bits;
+		if (!bits)
+			return 1 % m_;
+		auto bit = [&exponent](int i)
+		{
+			return (exponent[i / 32] >> (i % 32)) & 1;
+		};
+
+		int w = bits > 512 ? 6 : bits > 160 ? 5 : bits > 48 ? 4 : bits > 12 ? 3 : bits > 4 ? 2 : 1;
+		// table holds x, x^3, x^5, ... x^(2^w - 1)
+		std::vector < unsigned > table(k_ << (w - 1)), square(k_), acc(k_);
+		load(x, table.data());
+		if (montgomery_)
+			mul(table.data(), r2_.data(), table.data());
+		if (w > 1)
+			mul(table.data(), table.data(), square.data());
+		for (int i = 1; i < (1 << (w - 1)); ++i)
+			mul(table.data() + (i - 1) * k_, square.data(), table.data() + i * k_);
+
+		bool started = false;
+		for (int i = bits - 1; i >= 0;)
+		{
+			if (!bit(i))
+			{
+				mul(acc.data(), acc.data(), acc.data());
+				--i;
+				continue;
+			}
+			int l = std::max(i - w + 1, 0);
+			while (!bit(l))
+				++l;
+			int value = 0;
+			for (int j = i; j >= l; --j)
+			{
+				value = 2 * value + bit(j);
+				if (started)
+					mul(acc.data(), acc.data(), acc.data());
+			}
+			const unsigned *power = table.data() + (value >> 1) * k_;
+			if (started)
+				mul(acc.data(), power, acc.data());
+			else
+				std::copy(power, power + k_, acc.begin());
+			started = true;
+			i = l - 1;
+		}
+		if (montgomery_)
+		{
+			std::fill(t_.begin(), t_.end(), 0);
+			std::copy(acc.begin(), acc.end(), t_.begin());
+			reduce(acc.data());
+		}
+		return fromWords(acc.data(), k_);
+	}
+
+	// x^(-1) mod m in [0, m) by the extended Euclidean algorithm, or 0 when
+	// gcd(x, m) != 1
+	BigInteger invMod(const BigInteger &x) const
+	{
+		BigInteger a = m_, b = x % m_, u = 0, v = 1, r;
+		if (b.minus)
+			b += m_;
+		while (b)
+		{
+			a.divmod(b, r);
+			a *= v;
+			u -= a;
+			std::swap(u, v);
+			a = std::move(b);
+			b = std::move(r);
+		}
+		if (a != 1)
+			return 0;
+		if (u.minus)
+			u += m_;
+		return u % m_;
+	}
+
+private:
+	// |x| in base 2^32, at least one word
+	static std::vector < unsigned > toWords(BigInteger x)
+	{
+		std::vector < unsigned > res;
+		do
+		{
+			unsigned low = x.divSmall(1 << 16);
+			unsigned high = x.divSmall(1 << 16);
+			res.push_back(low | (high << 16));
+		} while (x);
+		return res;
+	}
+
+	// x[0 .. n) in base 10^9, with the limbs sized once up front: 32 bits
+	// take less than 32 / 29 limbs
+	static BigInteger fromWords(const unsigned *x, int n)
+	{
+		BigInteger res;
+		res.a.assign(n * 32 / 29 + 1, 0);
+		int len = 1;
+		for (int i = n - 1; i >= 0; --i)
+		{
+			unsigned long long carry = x[i];
+			for (int j = 0; j < len; ++j)
+			{
+				unsigned long long cur = ((unsigned long long)res.a[j] << 32) + carry;
+				res.a[j] = cur % INF;
+				carry = cur / INF;
+			}
+			for (; carry; carry /= INF)
+				res.a[len++] = carry % INF;
+		}
+		res.removeLeadingZeros();
+		return res;
+	}
+
+	// res[0 .. n + m) = x[0 .. n) * y[0 .. m)
+	static void mulWords(const unsigned *x, int n, const unsigned *y, int m, unsigned *res)
+	{
+		std::fill_n(res, n + m, 0);
+		for (int i = 0; i < n; ++i)
+		{
+			unsigned long long t = x[i], carry = 0;
+			for (int j = 0; j < m; ++j)
+			{
+				unsigned long long cur = t * y[j] + res[i + j] + carry;
+				res[i + j] = (unsigned)cur;
+				carry = cur >> 32;
+			}
+			res[i + m] = (unsigned)carry;
+		}
+	}
+
+	// res[0 .. 2n) = x[0 .. n)^2: every cross product is computed once and
+	// doubled, which saves almost half of the word products
+	static void sqrWords(const unsigned *x, int n, unsigned *res)
+	{
+		std::fill_n(res, 2 * n, 0);
+		for (int i = 0; i < n; ++i)
+		{
+			unsigned long long t = x[i], carry = 0;
+			for (int j = i + 1; j < n; ++j)
+			{
+				unsigned long long cur = t * x[j] + res[i + j] + carry;
+				res[i + j] = (unsigned)cur;
+				carry = cur >> 32;
+			}
+			res[i + n] = (unsigned)carry;
+		}
+		unsigned top = 0;
+		for (int i = 0; i < 2 * n; ++i)
+		{
+			unsigned w = res[i];
+			res[i] = (w << 1) | top;
+			top = w >> 31;
+		}
+		unsigned long long carry = 0;
+		for (int i = 0; i < n; ++i)
+		{
+			unsigned long long cur = 1ull * x[i] * x[i] + res[2 * i] + carry;
+			res[2 * i] = (unsigned)cur;
+			cur = (cur >> 32) + res[2 * i + 1];
+			res[2 * i + 1] = (unsigned)cur;
+			carry = cur >> 32;
+		}
+	}
+
+	// r[0 .. n) -= x[0 .. m) modulo 2^(32n)
+	static void subWords(unsigned *r, int n, const unsigned *x, int m)
+	{
+		unsigned long long borrow = 0;
+		int i = 0;
+		for (; i < m; ++i)
+		{
+			unsigned long long cur = (unsigned long long)r[i] - x[i] - borrow;
+			r[i] = (unsigned)cur;
+			borrow = cur >> 63;
+		}
+		for (; borrow && (i < n); ++i)
+			borrow = (r[i]-- == 0);
+	}
+
+	// res[0 .. k) = x mod m in [0, m); an x already in that range is
+	// converted limb by limb from the top, with no temporaries
+	void load(const BigInteger &x, unsigned *res) const
+	{
+		if (x.minus || !(x < m_))
+		{
+			BigInteger r = x % m_;
+			if (r.minus)
+				r += m_;
+			load(r, res);
+			return;
+		}
+		std::fill_n(res, k_, 0);
+		for (int i = x.a.size() - 1; i >= 0; --i)
+		{
+			unsigned long long carry = x.a[i];
+			for (int j = 0; j < k_; ++j)
+			{
+				unsigned long long cur = 1ull * res[j] * INF + carry;
+				res[j] = (unsigned)cur;
+				carry = cur >> 32;
+			}
+		}
+	}
+
+	// res[0 .. k) = x * y reduced; res may alias x or y
+	void mul(const unsigned *x, const unsigned *y, unsigned *res) const
+	{
+		if (x == y)
+			sqrWords(x, k_, t_.data());
+		else
+			mulWords(x, k_, y, k_, t_.data());
+		t_[2 * k_] = t_[2 * k_ + 1] = 0;
+		reduce(res);
+	}
+
+	// reduces t_ = x * y for x, y < m into res[0 .. k)
+	void reduce(unsigned *res) const
+	{
+		unsigned *t = t_.data();
+		const unsigned *m = m_words_.data();
+		if (montgomery_)
+		{
+			// adding u * m zeroes word i, so after k steps t / R is exact
+			// and below 2m
+			for (int i = 0; i < k_; ++i)
+			{
+				unsigned long long u = t[i] * inv_, carry = 0;
+				for (int j = 0; j < k_; ++j)
+				{
+					unsigned long long cur = u * m[j] + t[i + j] + carry;
+					t[i + j] = (unsigned)cur;
+					carry = cur >> 32;
+				}
+				for (int j = i + k_; carry; ++j)
+				{
+					unsigned long long cur = t[j] + carry;
+					t[j] = (unsigned)cur;
+					carry = cur >> 32;
+				}
+			}
+			t += k_;
+		}
+		else
+		{
+			// q = floor(floor(t / 2^(32(k-1))) * mu / 2^(32(k+1))) is at most
+			// three below t / m, and t - q * m is taken modulo 2^(32(k+1))
+			mulWords(t + k_ - 1, k_ + 1, mu_.data(), k_ + 1, q_.data());
+			mulWords(q_.data() + k_ + 1, k_ + 1, m, k_, r_.data());
+			subWords(t, k_ + 1, r_.data(), k_ + 1);
+		}
+		while (!belowModulus(t))
+			subWords(t, k_ + 1, m, k_);
+		std::copy(t, t + k_, res);
+	}
+
+	bool belowModulus(const unsigned *x) const
+	{
+		if (x[k_])
+			return false;
+		for (int i = k_ - 1; i >= 0; --i)
+			if (x[i] != m_words_[i])
+				return x[i] < m_words_[i];
+		return false;
+	}
+
+	BigInteger m_;
+	std::vector < unsigned > m_words_;
+	int k_;
+	bool montgomery_;
+	unsigned inv_;
+	std::vector < unsigned > r2_, mu_;
+	mutable std::vector < unsigned > t_, q_, r_, u_, v_;
+};
+
+// values written by BigInteger::serializeArray, read in place, e.g. from a
+// memory mapped file: open validates the whole layout once, and after that
+// a value costs one pass over its own limbs, with nothing else read or
+// copied
+class BigInteger::ArrayView
+{
+public:
+	ArrayView()
+		: entries_(nullptr)
+		, limbs_(nullptr)
+		, size_(0)
+	{}
+
+	// false, leaving the view empty, unless [data, data + bytes) begins with
+	// a complete array of this version whose values are in normal form
+	bool open(const void *data, size_t bytes)
+	{
+		const unsigned char *p = (const unsigned char *)data;
+		entries_ = limbs_ = nullptr;
+		size_ = 0;
+		static const unsigned char magic[8] = { 'B', 'I', 'G', 'A', 'R', 'R', 0, SERIAL_VERSION };
+		if ((bytes < 16) || !std::equal(magic, magic + 8, p))
+			return false;
+		unsigned long long n = readDoubleWord(p + 8);
+		if (n >= (bytes - 16) / 8)
+			return false;
+		const unsigned char *entries = p + 16, *limbs = entries + 8 * (n + 1);
+		unsigned long long total = readDoubleWord(entries + 8 * n);
+		if ((total & 1) || (total / 2 > (size_t)(p + bytes - limbs) / 4))
+			return false;
+		// the offsets first, so that no limb is read before every value is
+		// known to lie inside the limbs: they start at 0 and strictly grow
+		// up to the last entry, total, which was checked against the buffer
+		if (readDoubleWord(entries) >> 1)
+			return false;
+		for (size_t i = 0; i < n; ++i)
+		{
+			unsigned long long from = readDoubleWord(entries + 8 * i) >> 1;
+			unsigned long long to = readDoubleWord(entries + 8 * i + 8) >> 1;
+			if ((from >= to) || (to > total / 2))
+				return false;
+		}
+		for (size_t i = 0; i < n; ++i)
+		{
+			unsigned long long from = readDoubleWord(entries + 8 * i);
+			unsigned long long to = readDoubleWord(entries + 8 * i + 8) >> 1;
+			if (!validLimbs(limbs + 4 * (from >> 1), to - (from >> 1), from & 1))
+				return false;
+		}
+		entries_ = entries;
+		limbs_ = limbs;
+		size_ = n;
+		return true;
+	}
+
+	size_t size() const
+	{
+		return size_;
+	}
+
+	// number of limbs of value i, without reading them
+	size_t limbs(size_t i) const
+	{
+		return (readDoubleWord(entries_ + 8 * i + 8) >> 1) - (readDoubleWord(entries_ + 8 * i) >> 1);
+	}
+
+	BigInteger operator[](size_t i) const
+	{
+		unsigned long long from = readDoubleWord(entries_ + 8 * i);
+		size_t n = limbs(i);
+		const unsigned char *p = limbs_ + 4 * (from >> 1);
+		BigInteger res;
+		res.a.assign(n, 0);
+		for (size_t j = 0; j < n; ++j, p += 4)
+			res.a[j] = readWord(p);
+		res.minus = from & 1;
+		return res;
+	}
+
+private:
+	const unsigned char *entries_, *limbs_;
+	size_t size_;
+};
+
+// multiplies v[0..n) pairwise as a balanced tree, consuming the values;
+// while threads remain, a half worth more than thresholds().parallel limbs
+// is multiplied on its own thread
+BigInteger productTree(BigInteger *v, size_t n, unsigned threads)
+{
+	if (n == 1)
+		return std::move(v[0]);
+	size_t mid = n / 2;
+	if (threads > 1)
+	{
+		size_t size = 0;
+		for (size_t i = 0; i < n; ++i)
+			size += v[i].limbs();
+		if (size >= (size_t)BigInteger::thresholds().parallel)
+		{
+			std::future < BigInteger > left = std::async(std::launch::async, productTree, v, mid, threads / 2);
+			BigInteger res = productTree(v + mid, n - mid, threads - threads / 2);
+			res *= left.get();
+			return res;
+		}
+	}
+	BigInteger res = productTree(v, mid, 1);
+	res *= productTree(v + mid, n - mid, 1);
+	return res;
+}
+
+unsigned defaultThreads(unsigned threads)
+{
+	if (threads)
+		return threads;
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// product of [first, last) in a balanced tree, so that the multiplications
+// have operands of similar size and reach Karatsuba / Toom-3 / NTT instead
+// of growing one long value by short ones; threads = 0 means one per core
+template < class Iterator >
+BigInteger product(Iterator first, Iterator last, unsigned threads = 0)
+{
+	std::vector < BigInteger > v(first, last);
+	if (v.empty())
+		return 1;
+	return productTree(v.data(), v.size(), defaultThreads(threads));
+}
+
+// sum of [first, last): addition is already linear, so instead of a tree
+// every thread gets an Accumulator over a contiguous slice of the range
+template < class Iterator >
+BigInteger sum(Iterator first, Iterator last, unsigned threads = 0)
+{
+	std::vector < BigInteger > v(first, last);
+	size_t size = 0;
+	for (size_t i = 0; i < v.size(); ++i)
+		size += v[i].limbs();
+	threads = std::min(defaultThreads(threads), (unsigned)std::max((size_t)1, v.size()));
+	if (size < (size_t)BigInteger::thresholds().parallel)
+		threads = 1;
+	auto slice = [&v](size_t from, size_t to)
+	{
+		BigInteger::Accumulator acc;
+		for (size_t i = from; i < to; ++i)
+			acc += v[i];
+		return acc.result();
+	};
+	std::vector < std::future < BigInteger > > parts;
+	for (unsigned i = 1; i < threads; ++i)
+		parts.push_back(std::async(std::launch::async, slice, v.size() * i / threads, v.size() * (i + 1) / threads));
+	BigInteger res = slice(0, v.size() / threads);
+	for (size_t i = 0; i < parts.size(); ++i)
+		res += parts[i].get();
+	return res;
+}
+
+// from * (from + 1) * ... * to as leaves of a product tree, consecutive
+// factors packed into one int while it does not overflow
+std::vector < BigInteger > packedFactors(int from, int to)
+{
+	std::vector < BigInteger > factors;
+	long long packed = 1;
+	for (int i = std::max(from, 1); i <= to; ++i)
+	{
+		if (packed > INT_MAX / i)
+		{
+			factors.push_back(BigInteger((int)packed));
+			packed = 1;
+		}
+		packed *= i;
+	}
+	factors.push_back(BigInteger((int)packed));
+	return factors;
+}
+
+BigInteger factorial(int n, unsigned threads = 0)
+{
+	std::vector < BigInteger > factors = packedFactors(2, n);
+	return product(factors.begin(), factors.end(), threads);
+}
+
+// n choose k as (n - k + 1) * ... * n / k!, both sides product trees
+BigInteger binomial(int n, int k, unsigned threads = 0)
+{
+	if ((k < 0) || (k > n))
+		return 0;
+	k = std::min(k, n - k);
+	std::vector < BigInteger > factors = packedFactors(n - k + 1, n);
+	return product(factors.begin(), factors.end(), threads) / factorial(k, threads);
+}
@@ -0,0 +1,859 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <utility>
+
+// BigInteger with the same operator surface, but stored in 2^32 limbs, so
+// carries are shifts and masks instead of % and / by 10^9. Decimal text is
+// produced and consumed only by toChars / fromChars (and toString, the
+// string constructor and the stream operators on top of them), which split
+// recursively on the cached powers 10^(9 * 2^i).
+class BinaryBigInteger
+{
+private:
+	static const int BITS = 32;
+	static const unsigned DECIMAL_CHUNK = 1000000000;
+	static const int DECIMAL_CHUNK_DIGITS = 9;
+	std::vector < unsigned > a;
+	bool minus;
+
+	void removeLeadingZeros()
+	{
+		while ((a.size() > 1) && (a.back() == 0))
+			a.pop_back();
+		if ((a.size() == 1) && (a[0] == 0))
+			minus = false;
+	}
+
+	static BinaryBigInteger fromLimbs(const unsigned *x, int n)
+	{
+		BinaryBigInteger res;
+		if (n > 0)
+			res.a.assign(x, x + n);
+		res.removeLeadingZeros();
+		return res;
+	}
+
+	static int compareLimbs(const unsigned *x, int n, const unsigned *y, int m)
+	{
+		if (n != m)
+			return n < m ? -1 : 1;
+		for (int i = n - 1; i >= 0; --i)
+			if (x[i] != y[i])
+				return x[i] < y[i] ? -1 : 1;
+		return 0;
+	}
+
+	// r[0 .. n) += x[0 .. m), m <= n; returns the carry out of r[n - 1]
+	static unsigned addLimbs(unsigned *r, int n, const unsigned *x, int m)
+	{
+		unsigned long long carry = 0;
+		int i = 0;
+		for (; i < m; ++i)
+		{
+			carry += (unsigned long long)r[i] + x[i];
+			r[i] = (unsigned)carry;
+			carry >>= BITS;
+		}
+		for (; carry && (i < n); ++i)
+			carry = (++r[i] == 0);
+		return (unsigned)carry;
+	}
+
+	// r[0 .. n) -= x[0 .. m), m <= n; returns the borrow out of r[n - 1]
+	static unsigned subLimbs(unsigned *r, int n, const unsigned *x, int m)
+	{
+		unsigned borrow = 0;
+		int i = 0;
+		for (; i < m; ++i)
+		{
+			unsigned long long cur = (unsigned long long)r[i] - x[i] - borrow;
+			r[i] = (unsigned)cur;
+			borrow = (cur >> BITS) ? 1 : 0;
+		}
+		for (; borrow && (i < n); ++i)
+			borrow = (r[i]-- == 0);
+		return borrow;
+	}
+
+	void sum(const BinaryBigInteger &y, bool y_minus)
+	{
+		if (this == &y)
+		{
+			BinaryBigInteger copy = y;
+			sum(copy, y_minus);
+			return;
+		}
+		int n = a.size(), m = y.a.size();
+		if (minus == y_minus)
+		{
+			a.resize(std::max(n, m) + 1, 0);
+			addLimbs(a.data(), a.size(), y.a.data(), m);
+		}
+		else if (compareLimbs(a.data(), n, y.a.data(), m) >= 0)
+			subLimbs(a.data(), n, y.a.data(), m);
+		else
+		{
+			std::vector < unsigned > res = y.a;
+			subLimbs(res.data(), m, a.data(), n);
+			a.swap(res);
+			minus = y_minus;
+		}
+		removeLeadingZeros();
+	}
+
+	// res[0 .. n + m) = x[0 .. n) * y[0 .. m)
+	static void mulSchoolbook(const unsigned *x, int n, const unsigned *y, int m, unsigned *res)
+	{
+		std::fill_n(res, n + m, 0);
+		for (int i = 0; i < n; ++i)
+		{
+			unsigned long long t = x[i], carry = 0;
+			if (!t)
+				continue;
+			for (int j = 0; j < m; ++j)
+			{
+				carry += t * y[j] + res[i + j];
+				res[i + j] = (unsigned)carry;
+				carry >>= BITS;
+			}
+			res[i + m] = (unsigned)carry;
+		}
+	}
+
+	// res[0 .. 2n) = x[0 .. n) * y[0 .. n)
+	static void mulKaratsuba(const unsigned *x, const unsigned *y, int n, unsigned *res)
+	{
+		if (n <= std::max(thresholds().karatsuba, 3))
+		{
+			mulSchoolbook(x, n, y, n, res);
+			return;
+		}
+		int low = n / 2, high = n - low;
+		mulKaratsuba(x, y, low, res);
+		mulKaratsuba(x + low, y + low, high, res + 2 * low);
+		std::vector < unsigned > buf(4 * (high + 1), 0);
+		unsigned *sx = buf.data(), *sy = sx + high + 1, *mid = sy + high + 1;
+		std::copy_n(x + low, high, sx);
+		std::copy_n(y + low, high, sy);
+		addLimbs(sx, high + 1, x, low);
+		addLimbs(sy, high + 1, y, low);
+		mulKaratsuba(sx, sy, high + 1, mid);
+		int len = 2 * (high + 1);
+		subLimbs(mid, len, res, 2 * low);
+		subLimbs(mid, len, res + 2 * low, 2 * high);
+		while ((len > 0) && (mid[len - 1] == 0))
+			--len;
+		addLimbs(res + low, 2 * n - low, mid, len);
+	}
+
+	// res[0 .. n + m) = x[0 .. n) * y[0 .. m), dispatched on operand sizes
+	static void mulLimbs(const unsigned *x, int n, const unsigned *y, int m, unsigned *res)
+	{
+		if (n < m)
+		{
+			std::swap(x, y);
+			std::swap(n, m);
+		}
+		if (m <= thresholds().karatsuba)
+		{
+			mulSchoolbook(x, n, y, m, res);
+			return;
+		}
+		if (n >= 2 * m)
+		{
+			std::fill_n(res, n + m, 0);
+			std::vector < unsigned > cur(2 * m);
+			for (int off = 0; off < n; off += m)
+			{
+				int len = std::min(m, n - off);
+				mulLimbs(x + off, len, y, m, cur.data());
+				addLimbs(res + off, n + m - off, cur.data(), len + m);
+			}
+			return;
+		}
+		std::vector < unsigned > pad(y, y + m), full(2 * n);
+		pad.resize(n, 0);
+		mulKaratsuba(x, pad.data(), n, full.data());
+		std::copy_n(full.data(), n + m, res);
+	}
+
+	// magnitude *= d + add, for small d and add
+	void mulAddSmall(unsigned d, unsigned add)
+	{
+		unsigned long long carry = add;
+		for (int i = 0; i < (int)a.size(); ++i)
+		{
+			carry += (unsigned long long)a[i] * d;
+			a[i] = (unsigned)carry;
+			carry >>= BITS;
+		}
+		if (carry)
+			a.push_back((unsigned)carry);
+		removeLeadingZeros();
+	}
+
+	// divides the magnitude by a small d in place, returns the remainder
+	unsigned divSmall(unsigned d)
+	{
+		unsigned long long rem = 0;
+		for (int i = a.size() - 1; i >= 0; --i)
+		{
+			unsigned long long cur = (rem << BITS) | a[i];
+			a[i] = (unsigned)(cur / d);
+			rem = cur % d;
+		}
+		removeLeadingZeros();
+		return (unsigned)rem;
+	}
+
+	static int leadingZeros(unsigned x)
+	{
+		int res = 0;
+		for (unsigned bit = 1u << (BITS - 1); bit && !(x & bit); bit >>= 1)
+			++res;
+		return res;
+	}
+
+	// q[0 .. n - m] = u / v and r[0 .. m) = u % v for m >= 2 and v[m - 1] != 0,
+	// Knuth's algorithm D with the divisor normalised by a bit shift
+	static void divKnuth(const unsigned *u, int n, const unsigned *v, int m, unsigned *q, unsigned *r)
+	{
+		int s = leadingZeros(v[m - 1]);
+		std::vector < unsigned > un(n + 1), vn(m);
+		for (int i = m - 1; i > 0; --i)
+			vn[i] = s ? (v[i] << s) | (v[i - 1] >> (BITS - s)) : v[i];
+		vn[0] = v[0] << s;
+		un[n] = s ? u[n - 1] >> (BITS - s) : 0;
+		for (int i = n - 1; i > 0; --i)
+			un[i] = s ? (u[i] << s) | (u[i - 1] >> (BITS - s)) : u[i];
+		un[0] = u[0] << s;
+		const unsigned long long base = 1ull << BITS;
+		for (int j = n - m; j >= 0; --j)
+		{
+			unsigned long long num = ((unsigned long long)un[j + m] << BITS) | un[j + m - 1];
+			unsigned long long qhat = num / vn[m - 1], rhat = num % vn[m - 1];
+			while ((qhat >= base) || (qhat * vn[m - 2] > ((rhat << BITS) | un[j + m - 2])))
+			{
+				--qhat;
+				rhat += vn[m - 1];
+				if (rhat >= base)
+					break;
+			}
+			unsigned long long carry = 0;
+			unsigned borrow = 0;
+			for (int i = 0; i < m; ++i)
+			{
+				carry += qhat * vn[i];
+				unsigned long long cur = (unsigned long long)un[i + j] - (unsigned)carry - borrow;
+				carry >>= BITS;
+				un[i + j] = (unsigned)cur;
+				borrow = (cur >> BITS) ? 1 : 0;
+			}
+			unsigned long long top = (unsigned long long)un[j + m] - carry - borrow;
+			un[j + m] = (unsigned)top;
+			if (top >> BITS)
+			{
+				--qhat;
+				un[j + m] += addLimbs(un.data() + j, m, vn.data(), m);
+			}
+			q[j] = (unsigned)qhat;
+		}
+		for (int i = 0; i < m; ++i)
+			r[i] = s ? (un[i] >> s) | (un[i + 1] << (BITS - s)) : un[i];
+	}
+
+	void shiftLeftLimbs(int k)
+	{
+		if ((k > 0) && *this)
+			a.insert(a.begin(), k, 0);
+	}
+
+	void shiftRightLimbs(int k)
+	{
+		if (k >= (int)a.size())
+			a.assign(1, 0);
+		else
+			a.erase(a.begin(), a.begin() + k);
+		removeLeadingZeros();
+	}
+
+	static BinaryBigInteger powerOfBase(int k)
+	{
+		BinaryBigInteger res = 1;
+		res.shiftLeftLimbs(k);
+		return res;
+	}
+
+	// |x| / |y| for |x| >= |y| and a divisor of at least two limbs
+	static void divModKnuth(const BinaryBigInteger &x, const BinaryBigInteger &y, BinaryBigInteger &q, BinaryBigInteger &r)
+	{
+		int n = x.a.size(), m = y.a.size();
+		std::vector < unsigned > quot(n - m + 1), rem(m);
+		divKnuth(x.a.data(), n, y.a.data(), m, quot.data(), rem.data());
+		q.a.swap(quot);
+		q.minus = false;
+		q.removeLeadingZeros();
+		r.a.swap(rem);
+		r.minus = false;
+		r.removeLeadingZeros();
+	}
+
+	// floor(B^(2k) / v) for a k-limb v, Newton iteration with two guard limbs
+	static BinaryBigInteger reciprocal(const BinaryBigInteger &v)
+	{
+		int k = v.a.size();
+		if (k < std::max(thresholds().newton, 8))
+		{
+			BinaryBigInteger q, r;
+			divModKnuth(powerOfBase(2 * k), v, q, r);
+			return q;
+		}
+		int h = (k + 1) / 2 + 2;
+		BinaryBigInteger x = reciprocal(fromLimbs(v.a.data() + k - h, h));
+		x.shiftLeftLimbs(k - h);
+		BinaryBigInteger e = powerOfBase(2 * k), t = v;
+		t *= x;
+		e -= t;
+		e *= x;
+		e.shiftRightLimbs(2 * k);
+		x += e;
+		BinaryBigInteger r = powerOfBase(2 * k);
+		t = v;
+		t *= x;
+		r -= t;
+		while (r.minus)
+		{
+			--x;
+			r += v;
+		}
+		while (r >= v)
+		{
+			++x;
+			r -= v;
+		}
+		return x;
+	}
+
+	static void divNewton(const BinaryBigInteger &u, const BinaryBigInteger &v, BinaryBigInteger &q, BinaryBigInteger &r)
+	{
+		int n = u.a.size(), m = v.a.size();
+		int s = std::max(0, n - 2 * m);
+		BinaryBigInteger vs = v;
+		vs.shiftLeftLimbs(s);
+		BinaryBigInteger x = reciprocal(vs);
+		q = u;
+		q.shiftLeftLimbs(s);
+		q *= x;
+		q.shiftRightLimbs(2 * (m + s));
+		BinaryBigInteger t = q;
+		t *= v;
+		r = u;
+		r -= t;
+		while (r.minus)
+		{
+			--q;
+			r += v;
+		}
+		while (r >= v)
+		{
+			++q;
+			r -= v;
+		}
+	}
+
+	// q = |x| / |y| and r = |x| % |y| as non-negative values; q and r may
+	// alias x or y
+	static void divModMagnitude(const BinaryBigInteger &x, const BinaryBigInteger &y, BinaryBigInteger &q, BinaryBigInteger &r)
+	{
+		int n = x.a.size(), m = y.a.size();
+		if (compareLimbs(x.a.data(), n, y.a.data(), m) < 0)
+		{
+			r = x;
+			r.minus = false;
+			q = 0;
+			return;
+		}
+		if (m == 1)
+		{
+			unsigned d = y.a[0];
+			q = x;
+			q.minus = false;
+			r = 0;
+			r.a[0] = q.divSmall(d);
+			return;
+		}
+		if ((m >= thresholds().newton) && (n - m >= thresholds().newton))
+		{
+			BinaryBigInteger u = x, v = y;
+			u.minus = v.minus = false;
+			divNewton(u, v, q, r);
+			return;
+		}
+		divModKnuth(x, y, q, r);
+	}
+
+	// 10^(9 * 2^i) for i <= level, built once per thread and extended on demand
+	static const BinaryBigInteger &decimalPower(int level)
+	{
+		static thread_local std::vector < BinaryBigInteger > pow(1, BinaryBigInteger(DECIMAL_CHUNK));
+		while ((int)pow.size() <= level)
+		{
+			BinaryBigInteger next = pow.back();
+			next *= pow.back();
+			pow.push_back(std::move(next));
+		}
+		return pow[level];
+	}
+
+	// the level whose square is the first decimal power not below x
+	static int decimalLevel(const BinaryBigInteger &x)
+	{
+		int level = 0;
+		while (compareLimbs(decimalPower(level).a.data(), decimalPower(level).a.size(), x.a.data(), x.a.size()) < 0)
+			++level;
+		return level - 1;
+	}
+
+	// writes the digits of the magnitude of x to out, left padded with zeros
+	// to width (no padding for width 0), splitting on 10^(9 * 2^level) while x
+	// is large; returns the number of characters written
+	static int writeDecimal(const BinaryBigInteger &x, int level, int width, char *out)
+	{
+		if ((level < 0) || ((int)x.a.size() <= thresholds().conversion))
+		{
+			BinaryBigInteger cur = x;
+			std::vector < unsigned > chunks;
+			do
+				chunks.push_back(cur.divSmall(DECIMAL_CHUNK));
+			while (cur);
+			int len = DECIMAL_CHUNK_DIGITS * (chunks.size() - 1);
+			for (unsigned top = chunks.back(); top; top /= 10)
+				++len;
+			len = std::max(len, 1);
+			int total = std::max(len, width);
+			std::fill_n(out, total - len, '0');
+			char *p = out + total;
+			for (int i = 0; i < (int)chunks.size(); ++i)
+				for (int j = 0; (j < DECIMAL_CHUNK_DIGITS) && (p > out + total - len); ++j, chunks[i] /= 10)
+					*--p = '0' + chunks[i] % 10;
+			return total;
+		}
+		int len = DECIMAL_CHUNK_DIGITS << level;
+		BinaryBigInteger q, r;
+		divModMagnitude(x, decimalPower(level), q, r);
+		if ((width == 0) && !q)
+			return writeDecimal(r, level - 1, 0, out);
+		int high = writeDecimal(q, level - 1, width ? width - len : 0, out);
+		return high + writeDecimal(r, level - 1, len, out + high);
+	}
+
+	// the value of the decimal digits [first, last), split in halves on the
+	// largest power 10^(9 * 2^i) below their length
+	static BinaryBigInteger readDecimal(const char *first, const char *last)
+	{
+		int n = last - first;
+		if (n <= DECIMAL_CHUNK_DIGITS * thresholds().conversion)
+		{
+			BinaryBigInteger res;
+			int head = n % DECIMAL_CHUNK_DIGITS;
+			if (!head)
+				head = DECIMAL_CHUNK_DIGITS;
+			for (const char *p = first; p < last; p += head, head = DECIMAL_CHUNK_DIGITS)
+			{
+				unsigned chunk = 0, scale = 1;
+				for (int i = 0; i < head; ++i)
+				{
+					chunk = chunk * 10 + (p[i] - '0');
+					scale *= 10;
+				}
+				res.mulAddSmall(scale, chunk);
+			}
+			return res;
+		}
+		int level = 0;
+		while ((DECIMAL_CHUNK_DIGITS << (level + 1)) < n)
+			++level;
+		int len = DECIMAL_CHUNK_DIGITS << level;
+		BinaryBigInteger res = readDecimal(first, last - len);
+		res *= decimalPower(level);
+		res += readDecimal(last - len, last);
+		return res;
+	}
+
+public:
+	// operand sizes in limbs at which multiplication switches to Karatsuba,
+	// division to Newton reciprocals and decimal conversion to splitting
+	struct Thresholds
+	{
+		int karatsuba;
+		int newton;
+		int conversion;
+	};
+
+	static Thresholds &thresholds()
+	{
+		static Thresholds t = { 32, 2500, 40 };
+		return t;
+	}
+
+	BinaryBigInteger(const BinaryBigInteger &other)
+		: a(other.a)
+		, minus(other.minus)
+	{}
+
+	// the value moved from is left as 0, like BigInteger's; a std::vector
+	// has no inline limb, so that zero costs a one-limb allocation here,
+	// while move assignment reuses the limbs it gives up
+	BinaryBigInteger(BinaryBigInteger &&other) noexcept
+		: a(1, 0)
+		, minus(other.minus)
+	{
+		a.swap(other.a);
+		other.minus = false;
+	}
+
+	BinaryBigInteger(int x = 0)
+		: a(1, 0)
+		, minus(x < 0)
+	{
+		unsigned long long v = x < 0 ? -(long long)x : x;
+		a[0] = (unsigned)v;
+	}
+
+	BinaryBigInteger(const std::string &s)
+		: minus(false)
+	{
+		fromChars(s.data(), s.data() + s.size());
+	}
+
+	// parses an optional '-' followed by decimal digits from [first, last)
+	BinaryBigInteger &fromChars(const char *first, const char *last)
+	{
+		bool neg = (first != last) && (*first == '-');
+		if (neg)
+			++first;
+		*this = readDecimal(first, last);
+		minus = neg;
+		removeLeadingZeros();
+		return *this;
+	}
+
+	// upper bound on the number of characters toChars writes
+	size_t decimalLength() const
+	{
+		return a.size() * 10 + 1;
+	}
+
+	// writes the decimal form to buf without a terminator and returns its
+	// length; buf must hold decimalLength() characters
+	size_t toChars(char *buf) const
+	{
+		char *p = buf;
+		if (minus)
+			*p++ = '-';
+		return (p - buf) + writeDecimal(*this, decimalLevel(*this), 0, p);
+	}
+
+	const std::string toString() const
+	{
+		std::string s(decimalLength(), '0');
+		s.resize(toChars(&s[0]));
+		return s;
+	}
+
+	BinaryBigInteger& operator=(const BinaryBigInteger &b)
+	{
+		if (this == &b)
+		{
+			return *this;
+		}
+		a = b.a;
+		minus = b.minus;
+		return *this;
+	}
+
+	BinaryBigInteger& operator=(BinaryBigInteger &&b) noexcept
+	{
+		if (this == &b)
+		{
+			return *this;
+		}
+		a.swap(b.a);
+		minus = b.minus;
+		b.a.assign(1, 0);
+		b.minus = false;
+		return *this;
+	}
+
+	bool operator==(const BinaryBigInteger &b) const
+	{
+		return (a == b.a) && (minus == b.minus);
+	}
+
+	bool operator!=(const BinaryBigInteger &b) const
+	{
+		return !(*this == b);
+	}
+
+	bool operator<(const BinaryBigInteger &b) const
+	{
+		if (minus != b.minus)
+			return minus;
+		int cmp = compareLimbs(a.data(), a.size(), b.a.data(), b.a.size());
+		return minus ? cmp > 0 : cmp < 0;
+	}
+
+	bool operator<=(const BinaryBigInteger &b) const
+	{
+		return !(b < *this);
+	}
+
+	bool operator>(const BinaryBigInteger &b) const
+	{
+		return b < *this;
+	}
+
+	bool operator>=(const BinaryBigInteger &b) const
+	{
+		return !(*this < b);
+	}
+
+	explicit operator bool() const
+	{
+		return (a.size() != 1) || (a.back() != 0);
+	}
+
+	explicit operator double() const
+	{
+		double res = 0;
+		for (int i = a.size() - 1; i >= 0; --i)
+		{
+			res *= 4294967296.0;
+			res += a[i];
+		}
+		if (minus)
+			res *= -1;
+		return res;
+	}
+
+	BinaryBigInteger operator-() const &
+	{
+		BinaryBigInteger res = *this;
+		if (res)
+			res.minus = !minus;
+		return res;
+	}
+
+	BinaryBigInteger operator-() &&
+	{
+		if (*this)
+			minus = !minus;
+		return std::move(*this);
+	}
+
+	BinaryBigInteger operator +() const {
+		return *this;
+	}
+
+	BinaryBigInteger &operator+=(const BinaryBigInteger &b)
+	{
+		sum(b, b.minus);
+		return *this;
+	}
+
+	BinaryBigInteger &operator-=(const BinaryBigInteger &b)
+	{
+		sum(b, !b.minus);
+		return *this;
+	}
+
+	BinaryBigInteger &operator*=(const BinaryBigInteger &b)
+	{
+		bool res_minus = (minus != b.minus);
+		int n = a.size(), m = b.a.size();
+		std::vector < unsigned > res(n + m);
+		mulLimbs(a.data(), n, b.a.data(), m, res.data());
+		a.swap(res);
+		minus = res_minus;
+		removeLeadingZeros();
+		return *this;
+	}
+
+	BinaryBigInteger &operator/=(const BinaryBigInteger &b)
+	{
+		BinaryBigInteger rem;
+		return divmod(b, rem);
+	}
+
+	// *this becomes the quotient and rem the remainder of *this / b, rounded
+	// towards zero like the built-in integer division
+	BinaryBigInteger &divmod(const BinaryBigInteger &b, BinaryBigInteger &rem)
+	{
+		bool q_minus = (minus != b.minus), r_minus = minus;
+		divModMagnitude(*this, b, *this, rem);
+		minus = q_minus;
+		removeLeadingZeros();
+		rem.minus = r_minus;
+		rem.removeLeadingZeros();
+		return *this;
+	}
+
+	BinaryBigInteger &operator%=(const BinaryBigInteger &b)
+	{
+		BinaryBigInteger q = *this;
+		q.divmod(b, *this);
+		return *this;
+	}
+
+	BinaryBigInteger &operator++()
+	{
+		return *this += 1;
+	}
+
+	BinaryBigInteger &operator--()
+	{
+		return *this -= 1;
+	}
+
+	BinaryBigInteger operator++(int)
+	{
+		BinaryBigInteger old = *this;
+		*this += 1;
+		return old;
+	}
+
+	BinaryBigInteger operator--(int)
+	{
+		BinaryBigInteger old = *this;
+		*this -= 1;
+		return old;
+	}
+};
+
+std::istream &operator>>(std::istream &is, BinaryBigInteger &b)
+{
+	std::string s;
+	if (is >> s)
+		b.fromChars(s.data(), s.data() + s.size());
+	return is;
+}
+
+std::ostream &operator<<(std::ostream &os, const BinaryBigInteger &b)
+{
+	os << b.toString();
+	return os;
+}
+
+// the results are not const, and an rvalue operand is updated in place and
+// moved out, so in a * b + c * d - e no sum copies limbs: beyond the two
+// products there is only the one-limb zero each move leaves behind
+BinaryBigInteger operator+(const BinaryBigInteger &x, const BinaryBigInteger &y)
+{
+	BinaryBigInteger res = x;
+	res += y;
+	return res;
+}
+
+BinaryBigInteger operator+(BinaryBigInteger &&x, const BinaryBigInteger &y)
+{
+	x += y;
+	return std::move(x);
+}
+
+BinaryBigInteger operator+(const BinaryBigInteger &x, BinaryBigInteger &&y)
+{
+	y += x;
+	return std::move(y);
+}
+
+BinaryBigInteger operator+(BinaryBigInteger &&x, BinaryBigInteger &&y)
+{
+	x += y;
+	return std::move(x);
+}
+
+BinaryBigInteger operator-(const BinaryBigInteger &x, const BinaryBigInteger &y)
+{
+	BinaryBigInteger res = x;
+	res -= y;
+	return res;
+}
+
+BinaryBigInteger operator-(BinaryBigInteger &&x, const BinaryBigInteger &y)
+{
+	x -= y;
+	return std::move(x);
+}
+
+BinaryBigInteger operator-(const BinaryBigInteger &x, BinaryBigInteger &&y)
+{
+	y -= x;
+	return -std::move(y);
+}
+
+BinaryBigInteger operator-(BinaryBigInteger &&x, BinaryBigInteger &&y)
+{
+	x -= y;
+	return std::move(x);
+}
+
+BinaryBigInteger operator*(const BinaryBigInteger &x, const BinaryBigInteger &y)
+{
+	BinaryBigInteger res = x;
+	res *= y;
+	return res;
+}
+
+BinaryBigInteger operator*(BinaryBigInteger &&x, const BinaryBigInteger &y)
+{
+	x *= y;
+	return std::move(x);
+}
+
+BinaryBigInteger operator*(const BinaryBigInteger &x, BinaryBigInteger &&y)
+{
+	y *= x;
+	return std::move(y);
+}
+
+BinaryBigInteger operator*(BinaryBigInteger &&x, BinaryBigInteger &&y)
+{
+	x *= y;
+	return std::move(x);
+}
+
+BinaryBigInteger operator/(const BinaryBigInteger &x, const BinaryBigInteger &y)
+{
+	BinaryBigInteger res = x;
+	res /= y;
+	return res;
+}
+
+BinaryBigInteger operator/(BinaryBigInteger &&x, const BinaryBigInteger &y)
+{
+	x /= y;
+	return std::move(x);
+}
+
+BinaryBigInteger operator%(const BinaryBigInteger &x, const BinaryBigInteger &y)
+{
+	BinaryBigInteger res = x;
+	res %= y;
+	return res;
+}
+
+BinaryBigInteger operator%(BinaryBigInteger &&x, const BinaryBigInteger &y)
+{
+	x %= y;
+	return std::move(x);
+}
+
+std::pair < BinaryBigInteger, BinaryBigInteger > divmod(const BinaryBigInteger &x, const BinaryBigInteger &y)
+{
+	std::pair < BinaryBigInteger, BinaryBigInteger > res(x, 0);
+	res.first.divmod(y, res.second);
+	return res;
+}
@@ -0,0 +1,618 @@
+#pragma once
+#include "rational.h"
+
+// signed integer of exactly Bits bits (a multiple of 64) in Bits / 64 limbs
+// of 2^64 on the stack, two's complement, so +, - and * wrap modulo 2^Bits
+// like the built-in types and / and % truncate toward zero. Nothing
+// allocates, every loop runs over the compile-time limb count and unrolls,
+// and the arithmetic is constexpr. Conversions to and from BigInteger are
+// explicit, since they go through decimal text and may wrap.
+template < int Bits >
+class FixedBigInt
+{
+	static_assert((Bits > 0) && (Bits % 64 == 0), "FixedBigInt width must be a positive multiple of 64");
+
+public:
+	static const int N = Bits / 64;
+
+private:
+	typedef unsigned long long Limb;
+	static const Limb DECIMAL_CHUNK = 1000000000;
+	static const int DECIMAL_CHUNK_DIGITS = 9;
+	Limb a[N];
+
+	// x + y + carry; carry is 0 or 1 on both sides
+	static constexpr Limb addCarry(Limb x, Limb y, Limb &carry)
+	{
+#ifdef __SIZEOF_INT128__
+		unsigned __int128 s = (unsigned __int128)x + y + carry;
+		carry = (Limb)(s >> 64);
+		return (Limb)s;
+#else
+		Limb s = x + y;
+		Limb c = s < x;
+		s += carry;
+		carry = c + (s < carry);
+		return s;
+#endif
+	}
+
+	// x - y - borrow; borrow is 0 or 1 on both sides
+	static constexpr Limb subBorrow(Limb x, Limb y, Limb &borrow)
+	{
+		Limb d = x - y;
+		Limb b = x < y;
+		b += d < borrow;
+		d -= borrow;
+		borrow = b;
+		return d;
+	}
+
+	// x * y + add + carry, which always fits in two limbs; the high one goes
+	// to carry
+	static constexpr Limb mulAdd(Limb x, Limb y, Limb add, Limb &carry)
+	{
+#ifdef __SIZEOF_INT128__
+		unsigned __int128 p = (unsigned __int128)x * y + add + carry;
+		carry = (Limb)(p >> 64);
+		return (Limb)p;
+#else
+		Limb x0 = x & 0xFFFFFFFFu, x1 = x >> 32, y0 = y & 0xFFFFFFFFu, y1 = y >> 32;
+		Limb p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+		Limb mid = (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+		Limb lo = (p00 & 0xFFFFFFFFu) | (mid << 32);
+		Limb hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+		Limb c = 0;
+		lo = addCarry(lo, add, c);
+		hi += c;
+		c = 0;
+		lo = addCarry(lo, carry, c);
+		carry = hi + c;
+		return lo;
+#endif
+	}
+
+	constexpr bool negative() const
+	{
+		return a[N - 1] >> 63;
+	}
+
+	constexpr bool isZero() const
+	{
+		for (int i = 0; i < N; ++i)
+			if (a[i])
+				return false;
+		return true;
+	}
+
+	constexpr void negate()
+	{
+		Limb borrow = 0;
+		for (int i = 0; i < N; ++i)
+			a[i] = subBorrow(0, a[i], borrow);
+	}
+
+	constexpr FixedBigInt magnitude() const
+	{
+		FixedBigInt res = *this;
+		if (negative())
+			res.negate();
+		return res;
+	}
+
+	// compares the limbs as one unsigned number
+	constexpr bool lessUnsigned(const FixedBigInt &b) const
+	{
+		for (int i = N - 1; i >= 0; --i)
+			if (a[i] != b.a[i])
+				return a[i] < b.a[i];
+		return false;
+	}
+
+	constexpr void shiftLeft(int k)
+	{
+		int limbs = k / 64, bits = k % 64;
+		for (int i = N - 1; i >= 0; --i)
+		{
+			Limb x = i >= limbs ? a[i - limbs] : 0;
+			Limb y = (bits && (i > limbs)) ? a[i - limbs - 1] >> (64 - bits) : 0;
+			a[i] = (x << bits) | y;
+		}
+	}
+
+	// logical, as it only ever runs on magnitudes
+	constexpr void shiftRight(int k)
+	{
+		int limbs = k / 64, bits = k % 64;
+		for (int i = 0; i < N; ++i)
+		{
+			Limb x = i + limbs < N ? a[i + limbs] : 0;
+			Limb y = (bits && (i + limbs + 1 < N)) ? a[i + limbs + 1] << (64 - bits) : 0;
+			a[i] = (x >> bits) | y;
+		}
+	}
+
+	constexpr int trailingZeros() const
+	{
+		int res = 0;
+		for (int i = 0; i < N; ++i, res += 64)
+			if (a[i])
+			{
+				for (Limb x = a[i]; !(x & 1); x >>= 1)
+					++res;
+				return res;
+			}
+		return Bits;
+	}
+
+	// *this = *this * m + add for small m, treating the limbs as unsigned
+	constexpr void mulSmall(Limb m, Limb add)
+	{
+		for (int i = 0; i < N; ++i)
+			a[i] = mulAdd(a[i], m, 0, add);
+	}
+
+	// *this /= d for 0 < d < 2^32, treating the limbs as unsigned; returns
+	// the remainder
+	constexpr Limb divSmall(Limb d)
+	{
+		Limb r = 0;
+		for (int i = N - 1; i >= 0; --i)
+		{
+			Limb hi = (r << 32) | (a[i] >> 32);
+			Limb lo = ((hi % d) << 32) | (a[i] & 0xFFFFFFFFu);
+			a[i] = ((hi / d) << 32) | (lo / d);
+			r = lo % d;
+		}
+		return r;
+	}
+
+	// q = u / v and r = u % v for unsigned u and v by Knuth's algorithm D on
+	// 2^32 digits, so every step fits in 64 bits; as for the built-in types
+	// a zero divisor traps (and is not a constant expression)
+	static constexpr void divModUnsigned(const FixedBigInt &u, const FixedBigInt &v, FixedBigInt &q, FixedBigInt &r)
+	{
+		const int D = 2 * N;
+		const Limb BASE = 1ull << 32;
+		Limb ud[D] = {}, vd[D] = {}, qd[D] = {}, un[D + 1] = {}, vn[D] = {};
+		for (int i = 0; i < N; ++i)
+		{
+			ud[2 * i] = u.a[i] & 0xFFFFFFFFu;
+			ud[2 * i + 1] = u.a[i] >> 32;
+			vd[2 * i] = v.a[i] & 0xFFFFFFFFu;
+			vd[2 * i + 1] = v.a[i] >> 32;
+		}
+		int m = D, n = D;
+		while ((m > 0) && !ud[m - 1])
+			--m;
+		while ((n > 0) && !vd[n - 1])
+			--n;
+		if (n == 0)
+			n = 1 / (int)vd[0];
+		q = r = FixedBigInt();
+		if (m < n)
+		{
+			r = u;
+			return;
+		}
+		if (n == 1)
+		{
+			Limb k = 0;
+			for (int j = m - 1; j >= 0; --j)
+			{
+				qd[j] = (k * BASE + ud[j]) / vd[0];
+				k = (k * BASE + ud[j]) - qd[j] * vd[0];
+			}
+			ud[0] = k;
+			for (int j = 1; j < D; ++j)
+				ud[j] = 0;
+		}
+		else
+		{
+			// normalize so that the top divisor digit has its high bit set
+			int s = 0;
+			for (Limb x = vd[n - 1]; !(x & 0x80000000u); x <<= 1)
+				++s;
+			for (int i = n - 1; i > 0; --i)
+				vn[i] = ((vd[i] << s) | (vd[i - 1] >> (32 - s))) & 0xFFFFFFFFu;
+			vn[0] = (vd[0] << s) & 0xFFFFFFFFu;
+			un[m] = ud[m - 1] >> (32 - s);
+			for (int i = m - 1; i > 0; --i)
+				un[i] = ((ud[i] << s) | (ud[i - 1] >> (32 - s))) & 0xFFFFFFFFu;
+			un[0] = (ud[0] << s) & 0xFFFFFFFFu;
+			for (int j = m - n; j >= 0; --j)
+			{
+				Limb top = un[j + n] * BASE + un[j + n - 1];
+				Limb qhat = top / vn[n - 1], rhat = top % vn[n - 1];
+				while ((qhat >= BASE) || (qhat * vn[n - 2] > rhat * BASE + un[j + n - 2]))
+				{
+					--qhat;
+					rhat += vn[n - 1];
+					if (rhat >= BASE)
+						break;
+				}
+				// multiply and subtract, then add back once if qhat was one
+				// too large
+				long long t = 0, k = 0;
+				for (int i = 0; i < n; ++i)
+				{
+					Limb p = qhat * vn[i];
+					t = (long long)un[i + j] - k - (long long)(p & 0xFFFFFFFFu);
+					un[i + j] = (Limb)t & 0xFFFFFFFFu;
+					k = (long long)(p >> 32) - (t >> 32);
+				}
+				t = (long long)un[j + n] - k;
+				un[j + n] = (Limb)t & 0xFFFFFFFFu;
+				qd[j] = qhat;
+				if (t < 0)
+				{
+					--qd[j];
+					Limb c = 0;
+					for (int i = 0; i < n; ++i)
+					{
+						Limb sum = un[i + j] + vn[i] + c;
+						un[i + j] = sum & 0xFFFFFFFFu;
+						c = sum >> 32;
+					}
+					un[j + n] = (un[j + n] + c) & 0xFFFFFFFFu;
+				}
+			}
+			for (int i = 0; i < D; ++i)
+				ud[i] = i < n ? ((un[i] >> s) | (s ? (un[i + 1] << (32 - s)) : 0)) & 0xFFFFFFFFu : 0;
+		}
+		for (int i = 0; i < N; ++i)
+		{
+			q.a[i] = qd[2 * i] | (qd[2 * i + 1] << 32);
+			r.a[i] = ud[2 * i] | (ud[2 * i + 1] << 32);
+		}
+	}
+
+public:
+	constexpr FixedBigInt(long long x = 0)
+		: a()
+	{
+		for (int i = 0; i < N; ++i)
+			a[i] = x < 0 ? ~0ull : 0;
+		a[0] = (Limb)x;
+	}
+
+	explicit FixedBigInt(const std::string &s)
+		: a()
+	{
+		fromChars(s.data(), s.data() + s.size());
+	}
+
+	explicit FixedBigInt(const BigInteger &x)
+		: FixedBigInt(x.toString())
+	{}
+
+	explicit operator BigInteger() const
+	{
+		return BigInteger(toString());
+	}
+
+	// parses an optional '-' followed by decimal digits from [first, last),
+	// nine digits per multiply-add; values out of range wrap
+	constexpr FixedBigInt &fromChars(const char *first, const char *last)
+	{
+		bool minus = (first != last) && (*first == '-');
+		if (minus)
+			++first;
+		*this = FixedBigInt();
+		int n = last - first;
+		for (int begin = 0, len = (n - 1) % DECIMAL_CHUNK_DIGITS + 1; begin < n; begin += len, len = DECIMAL_CHUNK_DIGITS)
+		{
+			Limb chunk = 0, scale = 1;
+			for (int j = begin; j < begin + len; ++j)
+			{
+				chunk = chunk * 10 + (first[j] - '0');
+				scale *= 10;
+			}
+			mulSmall(scale, chunk);
+		}
+		if (minus)
+			negate();
+		return *this;
+	}
+
+	// upper bound on the number of characters toChars writes
+	static constexpr size_t decimalLength()
+	{
+		return Bits / 3 + 2;
+	}
+
+	// writes the decimal form to buf without a terminator and returns its
+	// length; buf must hold decimalLength() characters
+	constexpr size_t toChars(char *buf) const
+	{
+		char *p = buf;
+		if (negative())
+			*p++ = '-';
+		FixedBigInt x = magnitude();
+		char rev[Bits / 3 + 1] = {};
+		int len = 0;
+		do
+		{
+			Limb chunk = x.divSmall(DECIMAL_CHUNK);
+			bool last = x.isZero();
+			for (int j = 0; (j < DECIMAL_CHUNK_DIGITS) && (!last || chunk); ++j, chunk /= 10)
+				rev[len++] = '0' + chunk % 10;
+			if (last && !len)
+				rev[len++] = '0';
+		} while (!x.isZero());
+		while (len)
+			*p++ = rev[--len];
+		return p - buf;
+	}
+
+	const std::string toString() const
+	{
+		std::string s(decimalLength(), '0');
+		s.resize(toChars(&s[0]));
+		return s;
+	}
+
+	// number of nonzero 2^64 limbs of |x|; 1 for zero
+	constexpr size_t limbs() const
+	{
+		FixedBigInt x = magnitude();
+		int n = N;
+		while ((n > 1) && !x.a[n - 1])
+			--n;
+		return n;
+	}
+
+	// x ~ m * leadingBase()^e from the top two nonzero limbs, with
+	// 1 <= |m| < 2^64 of the sign of x (0 for zero), as for BigInteger
+	constexpr double leading(int &e) const
+	{
+		FixedBigInt x = magnitude();
+		int n = limbs();
+		e = n - 1;
+		double m = (double)x.a[n - 1];
+		if (n > 1)
+			m += (double)x.a[n - 2] * (1.0 / 18446744073709551616.0);
+		return negative() ? -m : m;
+	}
+
+	static constexpr double leadingBase()
+	{
+		return 18446744073709551616.0;
+	}
+
+	// number of decimal digits of |x|; 1 for zero
+	constexpr size_t digits() const
+	{
+		char buf[Bits / 3 + 2] = {};
+		return toChars(buf) - negative();
+	}
+
+	// greatest common divisor of |x| and |y| by the binary algorithm, which
+	// needs only shifts and subtractions
+	static constexpr FixedBigInt gcd(FixedBigInt x, FixedBigInt y)
+	{
+		x = x.magnitude();
+		y = y.magnitude();
+		if (x.isZero())
+			return y;
+		if (y.isZero())
+			return x;
+		int k = std::min(x.trailingZeros(), y.trailingZeros());
+		x.shiftRight(x.trailingZeros());
+		while (!y.isZero())
+		{
+			y.shiftRight(y.trailingZeros());
+			if (y.lessUnsigned(x))
+			{
+				FixedBigInt t = x;
+				x = y;
+				y = t;
+			}
+			Limb borrow = 0;
+			for (int i = 0; i < N; ++i)
+				y.a[i] = subBorrow(y.a[i], x.a[i], borrow);
+		}
+		x.shiftLeft(k);
+		return x;
+	}
+
+	// x^e modulo 2^Bits by left-to-right binary exponentiation
+	static constexpr FixedBigInt pow(const FixedBigInt &x, unsigned e)
+	{
+		FixedBigInt res = 1;
+		for (int i = 31; i >= 0; --i)
+		{
+			res *= res;
+			if ((e >> i) & 1)
+				res *= x;
+		}
+		return res;
+	}
+
+	constexpr bool operator==(const FixedBigInt &b) const
+	{
+		for (int i = 0; i < N; ++i)
+			if (a[i] != b.a[i])
+				return false;
+		return true;
+	}
+
+	constexpr bool operator!=(const FixedBigInt &b) const
+	{
+		return !(*this == b);
+	}
+
+	constexpr bool operator<(const FixedBigInt &b) const
+	{
+		if (negative() != b.negative())
+			return negative();
+		return lessUnsigned(b);
+	}
+
+	constexpr bool operator<=(const FixedBigInt &b) const
+	{
+		return !(b < *this);
+	}
+
+	constexpr bool operator>(const FixedBigInt &b) const
+	{
+		return b < *this;
+	}
+
+	constexpr bool operator>=(const FixedBigInt &b) const
+	{
+		return !(*this < b);
+	}
+
+	constexpr explicit operator bool() const
+	{
+		return !isZero();
+	}
+
+	explicit operator double() const
+	{
+		FixedBigInt x = magnitude();
+		double res = 0;
+		for (int i = N - 1; i >= 0; --i)
+			res = res * 18446744073709551616.0 + (double)x.a[i];
+		return negative() ? -res : res;
+	}
+
+	constexpr FixedBigInt operator-() const
+	{
+		FixedBigInt res = *this;
+		res.negate();
+		return res;
+	}
+
+	constexpr FixedBigInt &operator+=(const FixedBigInt &b)
+	{
+		Limb carry = 0;
+		for (int i = 0; i < N; ++i)
+			a[i] = addCarry(a[i], b.a[i], carry);
+		return *this;
+	}
+
+	constexpr FixedBigInt &operator-=(const FixedBigInt &b)
+	{
+		Limb borrow = 0;
+		for (int i = 0; i < N; ++i)
+			a[i] = subBorrow(a[i], b.a[i], borrow);
+		return *this;
+	}
+
+	// the low Bits bits of the product are the same for signed and unsigned
+	// operands, so only the limb pairs below the top are multiplied
+	constexpr FixedBigInt &operator*=(const FixedBigInt &b)
+	{
+		Limb res[N] = {};
+		for (int i = 0; i < N; ++i)
+		{
+			Limb carry = 0;
+			for (int j = 0; i + j < N; ++j)
+				res[i + j] = mulAdd(a[i], b.a[j], res[i + j], carry);
+		}
+		for (int i = 0; i < N; ++i)
+			a[i] = res[i];
+		return *this;
+	}
+
+	// quotient truncated toward zero, remainder with the sign of *this
+	constexpr FixedBigInt divmod(const FixedBigInt &b, FixedBigInt &rem) const
+	{
+		// rem may be *this or b, so the signs are read first
+		bool minus = negative(), flip = minus != b.negative();
+		FixedBigInt q;
+		divModUnsigned(magnitude(), b.magnitude(), q, rem);
+		if (flip)
+			q.negate();
+		if (minus)
+			rem.negate();
+		return q;
+	}
+
+	constexpr FixedBigInt &operator/=(const FixedBigInt &b)
+	{
+		FixedBigInt rem;
+		*this = divmod(b, rem);
+		return *this;
+	}
+
+	constexpr FixedBigInt &operator%=(const FixedBigInt &b)
+	{
+		divmod(b, *this);
+		return *this;
+	}
+
+	constexpr FixedBigInt &operator++()
+	{
+		return *this += 1;
+	}
+
+	constexpr FixedBigInt &operator--()
+	{
+		return *this -= 1;
+	}
+
+	constexpr FixedBigInt operator++(int)
+	{
+		FixedBigInt res = *this;
+		++*this;
+		return res;
+	}
+
+	constexpr FixedBigInt operator--(int)
+	{
+		FixedBigInt res = *this;
+		--*this;
+		return res;
+	}
+
+	// hidden friends, so that an integer converts on either side; the left
+	// operand is taken by value and updated in place
+	friend constexpr FixedBigInt operator+(FixedBigInt x, const FixedBigInt &y)
+	{
+		return x += y;
+	}
+
+	friend constexpr FixedBigInt operator-(FixedBigInt x, const FixedBigInt &y)
+	{
+		return x -= y;
+	}
+
+	friend constexpr FixedBigInt operator*(FixedBigInt x, const FixedBigInt &y)
+	{
+		return x *= y;
+	}
+
+	friend constexpr FixedBigInt operator/(FixedBigInt x, const FixedBigInt &y)
+	{
+		return x /= y;
+	}
+
+	friend constexpr FixedBigInt operator%(FixedBigInt x, const FixedBigInt &y)
+	{
+		return x %= y;
+	}
+
+	friend constexpr std::pair < FixedBigInt, FixedBigInt > divmod(const FixedBigInt &x, const FixedBigInt &y)
+	{
+		FixedBigInt rem;
+		FixedBigInt q = x.divmod(y, rem);
+		return std::pair < FixedBigInt, FixedBigInt > (q, rem);
+	}
+
+	friend std::istream &operator>>(std::istream &is, FixedBigInt &b)
+	{
+		std::string s;
+		if (is >> s)
+			b.fromChars(s.data(), s.data() + s.size());
+		return is;
+	}
+
+	friend std::ostream &operator<<(std::ostream &os, const FixedBigInt &b)
+	{
+		os << b.toString();
+		return os;
+	}
+};
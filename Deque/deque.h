@@ -3,19 +3,35 @@
 #include <iterator>
 #include <algorithm>
 #include <cstring>
-
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// an iterator keeps its index for comparisons and arithmetic, and a pointer
+// into the contiguous span of live elements around it, so dereferencing and
+// stepping within a block touch only that pointer; the deque is consulted
+// again only when a step leaves the span or jumps
 template < class MyDeque, class MyDequePtr >
 class Iterators
-	: public std::iterator < std::random_access_iterator_tag,
-		typename MyDeque::ValueType, size_t >
 {
 public:
 	typedef typename MyDeque::ValueType T;
 	typedef Iterators < MyDeque, MyDequePtr > MyIter;
 
+	typedef std::random_access_iterator_tag iterator_category;
+	typedef T value_type;
+	typedef ptrdiff_t difference_type;
+	typedef T* pointer;
+	typedef T& reference;
+
 	Iterators()
 		: d_()
 		, index_(0)
+		, cur_()
+		, first_()
+		, last_()
 	{
 
 	}
@@ -23,30 +39,56 @@ public:
 	Iterators(const Iterators& other)
 		: d_(other.d_)
 		, index_(other.index_)
+		, cur_(other.cur_)
+		, first_(other.first_)
+		, last_(other.last_)
 	{
 
 	}
 
+	Iterators& operator=(const Iterators& other)
+	{
+		d_ = other.d_;
+		index_ = other.index_;
+		cur_ = other.cur_;
+		first_ = other.first_;
+		last_ = other.last_;
+		return (*this);
+	}
+
 	Iterators(size_t index_, MyDequePtr x)
 		: d_(x)
 		, index_(index_)
 	{
-
+		Seat_();
 	}
 
 	T& operator*() const
 	{
-		return (*d_)[index_];
+		return *cur_;
 	}
 
 	T* operator->() const
 	{
-		return &((*d_)[index_]);
+		return cur_;
+	}
+
+	// the live elements stored contiguously with this one
+	T* segment_begin() const
+	{
+		return first_;
+	}
+
+	T* segment_end() const
+	{
+		return last_;
 	}
 
 	MyIter& operator++()
 	{
 		++index_;
+		if (++cur_ == last_)
+			Seat_();
 		return (*this);
 	}
 
@@ -60,6 +102,10 @@ public:
 	MyIter& operator--()
 	{
 		--index_;
+		if (cur_ == first_)
+			Seat_();
+		else
+			--cur_;
 		return (*this);
 	}
 
@@ -70,36 +116,39 @@ public:
 		return tmp;
 	}
 
-	MyIter& operator+=(size_t x)
+	MyIter& operator+=(ptrdiff_t x)
 	{
 		index_ += x;
+		if (x < first_ - cur_ || x >= last_ - cur_)
+			Seat_();
+		else
+			cur_ += x;
 		return (*this);
 	}
 
-	MyIter operator+(size_t x) const
+	MyIter operator+(ptrdiff_t x) const
 	{
 		MyIter tmp = *this;
 		return tmp += x;
 	}
 
-	MyIter& operator-=(size_t x)
+	MyIter& operator-=(ptrdiff_t x)
 	{
-		index_ -= x;
-		return (*this);
+		return (*this += -x);
 	}
 
-	MyIter operator-(size_t x) const
+	MyIter operator-(ptrdiff_t x) const
 	{
 		MyIter tmp = *this;
 		return tmp -= x;
 	}
 
-	int operator-(const MyIter& other) const
+	ptrdiff_t operator-(const MyIter& other) const
 	{
-		return (int)index_ - other.index_;
+		return (ptrdiff_t)(index_ - other.index_);
 	}
 
-	T& operator[](size_t x) const
+	T& operator[](ptrdiff_t x) const
 	{
 		return (*(*this + x));
 	}
@@ -135,63 +184,250 @@ public:
 	}
 
 private:
+	// outside the elements, at end() say, the span is empty
+	void Seat_()
+	{
+		if (index_ < d_->size())
+			d_->Locate_(index_, cur_, first_, last_);
+		else
+			cur_ = first_ = last_ = nullptr;
+	}
+
 	MyDequePtr d_;
 	size_t index_;
+	T* cur_;
+	T* first_;
+	T* last_;
 };
 
 template < class MyDeque, class MyDequePtr >
 	Iterators < MyDeque, MyDequePtr > operator+(
-		size_t x, Iterators < MyDeque, MyDequePtr > it)
+		ptrdiff_t x, Iterators < MyDeque, MyDequePtr > it)
 {
 	return it += x;
 }
 
-template < class T >
+// the contiguous spans of a range of deque iterators, in order, each as a
+// pair of pointers, so an algorithm can run a plain loop over every one
+template < class MyIter >
+class Segments
+{
+public:
+	typedef typename MyIter::T T;
+	typedef std::pair < T*, T* > Span;
+
+	class iterator
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef Span value_type;
+		typedef ptrdiff_t difference_type;
+		typedef Span* pointer;
+		typedef Span reference;
+
+		iterator(const MyIter& it, const MyIter& last)
+			: it_(it)
+			, last_(last)
+		{
+
+		}
+
+		Span operator*() const
+		{
+			T* first = &*it_;
+			ptrdiff_t n = std::min(it_.segment_end() - first, last_ - it_);
+			return Span(first, first + n);
+		}
+
+		iterator& operator++()
+		{
+			it_ += it_.segment_end() - &*it_;
+			if (last_ < it_)
+				it_ = last_;
+			return (*this);
+		}
+
+		iterator operator++(int)
+		{
+			iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		bool operator==(const iterator& other) const
+		{
+			return it_ == other.it_;
+		}
+
+		bool operator!=(const iterator& other) const
+		{
+			return !(*this == other);
+		}
+
+	private:
+		MyIter it_;
+		MyIter last_;
+	};
+
+	Segments(const MyIter& first, const MyIter& last)
+		: first_(first)
+		, last_(last)
+	{
+
+	}
+
+	iterator begin() const
+	{
+		return iterator(first_, last_);
+	}
+
+	iterator end() const
+	{
+		return iterator(last_, last_);
+	}
+
+private:
+	MyIter first_;
+	MyIter last_;
+};
+
+// growth policy of a Deque. The block map starts at MinMapSize slots and is
+// multiplied by Factor when full; both must be powers of two. A block left
+// empty by a pop is kept for reuse until the blocks outnumber ShrinkRatio
+// times the live ones plus two, and forever if ShrinkRatio is 0, so with
+// reserve() a deque can be pinned to make no allocations in steady state
+template < size_t Factor = 2, size_t MinMapSize = 8, size_t ShrinkRatio = 2 >
+struct DequeGrowth
+{
+	static_assert(Factor >= 2 && !(Factor & (Factor - 1)), "Factor must be a power of two");
+	static_assert(MinMapSize >= 2 && !(MinMapSize & (MinMapSize - 1)), "MinMapSize must be a power of two");
+
+	static const size_t FACTOR = Factor;
+	static const size_t MIN_MAP_SIZE = MinMapSize;
+	static const size_t SHRINK_RATIO = ShrinkRatio;
+};
+
+// elements live in fixed blocks of BLOCK_SIZE_, a power of two, whose
+// pointers form a circular map; element i is at position (head_ + i) modulo
+// the map capacity. Pushes and pops at either end move head_ or size_ and
+// never copy elements, blocks never move, so references stay valid on push,
+// and growing the map copies only block pointers. Blocks are raw storage:
+// an element is constructed in place by a push and destroyed by its pop
+template < class T, class Growth = DequeGrowth <> >
 class Deque
 {
 public:
-	typedef Iterators < Deque < T >, const Deque < T >* > const_iterator;
-	typedef Iterators < Deque < T >, Deque < T >* > iterator;
+	typedef Iterators < Deque, const Deque* > const_iterator;
+	typedef Iterators < Deque, Deque* > iterator;
 	typedef std::reverse_iterator < iterator > reverse_iterator;
 	typedef std::reverse_iterator < const_iterator > const_reverse_iterator;
 	typedef T ValueType;
 
-	explicit Deque(size_t n = 0, T x = T())
+	friend iterator;
+	friend const_iterator;
+
+	Deque()
 	{
-		Build_(back_stack_, back_size_, back_index_, n / 2, x);
-		Build_(front_stack_, front_size_, front_index_, n - n / 2, x);
+		Build_(0);
 	}
 
+	explicit Deque(size_t n, const T& x = T())
+	{
+		Build_(n);
+		try
+		{
+			for (size_t i = 0; i < n; ++i)
+				push_back(x);
+		}
+		catch (...)
+		{
+			Destroy_();
+			throw;
+		}
+	}
+
+	// the copy starts at the same offset in its first block, so the blocks
+	// line up and each one is copied as a single span
 	explicit Deque(const Deque &other)
-		: front_size_(other.front_size_)
-		, back_size_(other.back_size_)
-		, front_index_(other.front_index_)
-		, back_index_(other.back_index_)
 	{
-		BuildArrayAndCopy_(other.back_stack_, back_stack_, back_index_, other.back_size_);
-		BuildArrayAndCopy_(other.front_stack_, front_stack_, front_index_, other.front_size_);
+		Build_(other.size_);
+		head_ = other.head_ & (BLOCK_SIZE_ - 1);
+		try
+		{
+			for (size_t i = 0; i < other.size_; )
+			{
+				size_t pos = (head_ + i) & Mask_();
+				size_t n = std::min(other.size_ - i, BLOCK_SIZE_ - (pos & (BLOCK_SIZE_ - 1)));
+				T* to = Block_(pos) + (pos & (BLOCK_SIZE_ - 1));
+				const T* from = &other.IthElement_(i);
+				CopySpan_(from, n, to);
+				size_ += n;
+				i += n;
+			}
+		}
+		catch (...)
+		{
+			Destroy_();
+			throw;
+		}
+	}
+
+	template < class InputIt,
+		class = typename std::iterator_traits < InputIt >::iterator_category >
+	Deque(InputIt first, InputIt last)
+	{
+		Build_(0);
+		try
+		{
+			append(first, last);
+		}
+		catch (...)
+		{
+			Destroy_();
+			throw;
+		}
+	}
+
+	Deque(std::initializer_list < T > init)
+		: Deque(init.begin(), init.end())
+	{
+
+	}
+
+	Deque(Deque &&other) noexcept
+	{
+		Build_(0);
+		Swap_(other);
 	}
 
 	~Deque()
 	{
-		delete[] back_stack_;
-		delete[] front_stack_;
+		Destroy_();
 	}
 
 	Deque &operator=(const Deque &other)
 	{
-		front_size_ = other.front_size_;
-		back_size_ = other.back_size_;
-		front_index_ = other.front_index_;
-		back_index_ = other.back_index_;
-		ResizeAndCopy_(other.back_stack_, back_stack_, back_index_, back_size_);
-		ResizeAndCopy_(other.front_stack_, front_stack_, front_index_, front_size_);
+		if (this != &other)
+		{
+			Deque tmp(other);
+			Swap_(tmp);
+		}
+		return *this;
+	}
+
+	Deque &operator=(Deque &&other) noexcept
+	{
+		if (this != &other)
+		{
+			Deque tmp(std::move(other));
+			Swap_(tmp);
+		}
 		return *this;
 	}
 
 	size_t size() const
 	{
-		return back_index_ + front_index_;
+		return size_;
 	}
 
 	bool empty() const
@@ -199,24 +435,24 @@ public:
 		return (!(this->size()));
 	}
 
-	T back() const
+	const T& back() const
 	{
-		return FrontOrBackElement_(back_stack_, front_stack_, back_index_);
+		return IthElement_(size_ - 1);
 	}
 
-	T back()
+	T& back()
 	{
-		return FrontOrBackElement_(back_stack_, front_stack_, back_index_);
+		return IthElement_(size_ - 1);
 	}
 
-	T front() const
+	const T& front() const
 	{
-		return FrontOrBackElement_(front_stack_, back_stack_, front_index_);
+		return IthElement_(0);
 	}
 
-	T front()
+	T& front()
 	{
-		return FrontOrBackElement_(front_stack_, back_stack_, front_index_);
+		return IthElement_(0);
 	}
 
 	T& operator[](const size_t& index) const
@@ -231,22 +467,132 @@ public:
 
 	void push_back(const T& x)
 	{
-		Insert_(back_stack_, back_index_, back_size_, x);
+		emplace_back(x);
+	}
+
+	void push_back(T&& x)
+	{
+		emplace_back(std::move(x));
 	}
 
 	void push_front(const T& x)
 	{
-		Insert_(front_stack_, front_index_, front_size_, x);
+		emplace_front(x);
+	}
+
+	void push_front(T&& x)
+	{
+		emplace_front(std::move(x));
+	}
+
+	// if the constructor throws, the deque is left as it was; an argument
+	// may refer to an element, since nothing moves before it is read
+	template < class... Args >
+	T& emplace_back(Args&&... args)
+	{
+		GrowIfFull_();
+		size_t pos = (head_ + size_) & Mask_();
+		T* p = new (Block_(pos) + (pos & (BLOCK_SIZE_ - 1))) T(std::forward < Args >(args)...);
+		++size_;
+		return *p;
+	}
+
+	template < class... Args >
+	T& emplace_front(Args&&... args)
+	{
+		GrowIfFull_();
+		size_t pos = (head_ - 1) & Mask_();
+		T* p = new (Block_(pos) + (pos & (BLOCK_SIZE_ - 1))) T(std::forward < Args >(args)...);
+		head_ = pos;
+		++size_;
+		return *p;
 	}
 
 	void pop_back()
 	{
-		Remove_(back_stack_, front_stack_, back_size_, front_size_, back_index_, front_index_);
+		--size_;
+		size_t pos = (head_ + size_) & Mask_();
+		map_[pos >> BLOCK_SHIFT_][pos & (BLOCK_SIZE_ - 1)].~T();
+		if (!(pos & (BLOCK_SIZE_ - 1)))
+			Vacate_(pos >> BLOCK_SHIFT_);
 	}
 
 	void pop_front()
 	{
-		Remove_(front_stack_, back_stack_, front_size_, back_size_, front_index_, back_index_);
+		size_t pos = head_;
+		map_[pos >> BLOCK_SHIFT_][pos & (BLOCK_SIZE_ - 1)].~T();
+		head_ = (head_ + 1) & Mask_();
+		--size_;
+		if (!(head_ & (BLOCK_SIZE_ - 1)))
+			Vacate_(pos >> BLOCK_SHIFT_);
+	}
+
+	// the bulk pops destroy a block's worth of elements at a time
+	void pop_back(size_t n)
+	{
+		while (n)
+		{
+			size_t last = (head_ + size_ - 1) & Mask_();
+			size_t run = std::min(n, (last & (BLOCK_SIZE_ - 1)) + 1);
+			size_t pos = (last - run + 1) & Mask_();
+			DestroySpan_(map_[pos >> BLOCK_SHIFT_] + (pos & (BLOCK_SIZE_ - 1)), run);
+			size_ -= run;
+			n -= run;
+			if (!(pos & (BLOCK_SIZE_ - 1)))
+				Vacate_(pos >> BLOCK_SHIFT_);
+		}
+	}
+
+	void pop_front(size_t n)
+	{
+		while (n)
+		{
+			size_t pos = head_;
+			size_t run = std::min(n, BLOCK_SIZE_ - (pos & (BLOCK_SIZE_ - 1)));
+			DestroySpan_(map_[pos >> BLOCK_SHIFT_] + (pos & (BLOCK_SIZE_ - 1)), run);
+			head_ = (head_ + run) & Mask_();
+			size_ -= run;
+			n -= run;
+			if (!(head_ & (BLOCK_SIZE_ - 1)))
+				Vacate_(pos >> BLOCK_SHIFT_);
+		}
+	}
+
+	// appends [first, last), a block at a time when its length is known; if
+	// an element's constructor throws, the deque is left as it was
+	template < class InputIt >
+	void append(InputIt first, InputIt last)
+	{
+		Append_(first, last, typename std::iterator_traits < InputIt >::iterator_category());
+	}
+
+	// inserts [first, last) before pos by moving the shorter side of the
+	// deque; for trivially copyable elements every step is a memmove or
+	// memcpy of a block segment
+	template < class InputIt >
+	iterator insert(iterator pos, InputIt first, InputIt last)
+	{
+		size_t index = pos - begin();
+		Insert_(index, first, last, typename std::iterator_traits < InputIt >::iterator_category());
+		return begin() + index;
+	}
+
+	// closes the gap by moving the shorter side of the deque
+	iterator erase(iterator first, iterator last)
+	{
+		size_t from = first - begin();
+		size_t n = last - first;
+		if (from < size_ - from - n)
+		{
+			Move_(0, n, from);
+			pop_front(n);
+		}
+		else
+		{
+			Move_(from + n, from, size_ - from - n);
+			pop_back(n);
+		}
+		return begin() + from;
 	}
 
 	iterator begin()
@@ -309,127 +655,469 @@ public:
 		return rend();
 	}
 
-	size_t GetFrontSize() const
+	Segments < iterator > segments()
+	{
+		return Segments < iterator >(begin(), end());
+	}
+
+	Segments < const_iterator > segments() const
+	{
+		return Segments < const_iterator >(begin(), end());
+	}
+
+	// calls fn(first, last) on each contiguous span of elements in order
+	template < class Fn >
+	void for_each_segment(Fn fn)
 	{
-		return front_size_;
+		for (size_t i = 0; i < size_; )
+		{
+			size_t pos = (head_ + i) & Mask_();
+			size_t run = std::min(size_ - i, BLOCK_SIZE_ - (pos & (BLOCK_SIZE_ - 1)));
+			T* first = map_[pos >> BLOCK_SHIFT_] + (pos & (BLOCK_SIZE_ - 1));
+			fn(first, first + run);
+			i += run;
+		}
+	}
+
+	template < class Fn >
+	void for_each_segment(Fn fn) const
+	{
+		const_cast < Deque* >(this)->for_each_segment([&fn](T* first, T* last)
+		{
+			fn((const T*)first, (const T*)last);
+		});
 	}
 
-	size_t GetBackSize() const
+	size_t GetBlockSize() const
 	{
-		return back_size_;
+		return BLOCK_SIZE_;
 	}
 
-	size_t GetFrontIndex() const
+	size_t GetMapSize() const
 	{
-		return front_index_;
+		return map_size_;
 	}
 
-	size_t GetBackIndex() const
+	size_t GetBlocks() const
 	{
-		return back_index_;
+		return blocks_;
 	}
 
 	size_t GetMinSize() const
 	{
-		return MIN_SIZE_;
+		return MIN_MAP_SIZE_;
 	}
 
-private:
-	void ResizeAndCopy_(const T* from, T* &to, size_t index, size_t size)
+	// makes room for front more elements before the first and back more
+	// after the last, so the pushes that use it allocate nothing
+	void reserve(size_t front, size_t back)
 	{
-		delete to;
-		BuildArrayAndCopy_(from, to, size, size);
+		size_t need = size_ + front + back;
+		if (!need)
+			return;
+		if (need + BLOCK_SIZE_ > map_size_ * BLOCK_SIZE_)
+			Remap_(MapSizeFor_(need, map_size_));
+		size_t pos = (head_ - front) & Mask_();
+		for (size_t i = 0; i < need; i += BLOCK_SIZE_)
+			Block_((pos + i) & Mask_());
+		Block_((pos + need - 1) & Mask_());
 	}
 
-	void FindSize_(size_t& size, size_t index)
+	// frees every block holding no element and shrinks the map to the
+	// smallest size the policy allows for the current elements
+	void shrink_to_fit()
 	{
-		size = MIN_SIZE_;
-		while (size <= index)
-			size <<= 1;
+		if (!map_)
+			return;
+		size_t first = head_ >> BLOCK_SHIFT_;
+		for (size_t i = UsedBlocks_(); i < map_size_; ++i)
+			if (T* block = map_[(first + i) & (map_size_ - 1)])
+			{
+				map_[(first + i) & (map_size_ - 1)] = nullptr;
+				FreeBlock_(block);
+			}
+		while (spare_)
+			FreeBlock_(PopSpare_());
+		if (!size_)
+		{
+			delete[] map_;
+			Build_(0);
+			return;
+		}
+		size_t map_size = MapSizeFor_(size_, 0);
+		if (map_size < map_size_)
+			Remap_(map_size);
 	}
 
-	void Build_(T*& a, size_t& size, size_t& index, size_t n, const T& x)
+private:
+	// about 4 KiB of elements, at least 16, rounded down to a power of two
+	static const size_t BLOCK_SHIFT_ = sizeof(T) >= 256 ? 4 :
+		sizeof(T) >= 128 ? 5 : sizeof(T) >= 64 ? 6 : sizeof(T) >= 32 ? 7 :
+		sizeof(T) >= 16 ? 8 : sizeof(T) >= 8 ? 9 : sizeof(T) >= 4 ? 10 :
+		sizeof(T) >= 2 ? 11 : 12;
+	static const size_t BLOCK_SIZE_ = (size_t)1 << BLOCK_SHIFT_;
+	static const size_t MIN_MAP_SIZE_ = Growth::MIN_MAP_SIZE;
+	static const size_t FACTOR_ = Growth::FACTOR;
+	static const size_t SHRINK_RATIO_ = Growth::SHRINK_RATIO;
+
+	// an empty deque has no map until its first push, so default
+	// construction and moved-from deques allocate nothing
+	void Build_(size_t n)
+	{
+		map_ = nullptr;
+		spare_ = nullptr;
+		map_size_ = 0;
+		head_ = 0;
+		size_ = 0;
+		blocks_ = 0;
+		if (!n)
+			return;
+		map_size_ = MapSizeFor_(n, 0);
+		map_ = new T*[map_size_]();
+	}
+
+	// the first size reached from map_size by the growth factor whose map
+	// holds n elements; the last slot stays free so both ends never meet
+	static size_t MapSizeFor_(size_t n, size_t map_size)
+	{
+		if (map_size < MIN_MAP_SIZE_)
+			map_size = MIN_MAP_SIZE_;
+		while ((map_size - 1) * BLOCK_SIZE_ < n)
+			map_size *= FACTOR_;
+		return map_size;
+	}
+
+	void Destroy_()
+	{
+		if (!std::is_trivially_destructible < T >::value)
+			for (size_t i = 0; i < size_; ++i)
+				IthElement_(i).~T();
+		for (size_t i = 0; i < map_size_; ++i)
+			if (map_[i])
+				FreeBlock_(map_[i]);
+		while (spare_)
+			FreeBlock_(PopSpare_());
+		delete[] map_;
+	}
+
+	// constructs n copies of from at the raw storage to, one memcpy for
+	// trivially copyable types; on a throw the copies made so far are
+	// destroyed again
+	static void CopySpan_(const T* from, size_t n, T* to)
+	{
+		if (std::is_trivially_copyable < T >::value)
+		{
+			std::memcpy((void*)to, (const void*)from, n * sizeof(T));
+			return;
+		}
+		size_t i = 0;
+		try
+		{
+			for (; i < n; ++i)
+				new (to + i) T(from[i]);
+		}
+		catch (...)
+		{
+			while (i)
+				to[--i].~T();
+			throw;
+		}
+	}
+
+	template < class It >
+	static void ConstructSpan_(It& first, size_t n, T* to)
 	{
-		index = n;
-		FindSize_(size, index);
-		a = new T[size];
-		std::fill_n(a, size, x);
+		size_t i = 0;
+		try
+		{
+			for (; i < n; ++i, ++first)
+				new (to + i) T(*first);
+		}
+		catch (...)
+		{
+			while (i)
+				to[--i].~T();
+			throw;
+		}
 	}
 
-	void BuildArrayAndCopy_(const T* from, T*& to, size_t n, size_t size)
+	static void ConstructSpan_(const T*& first, size_t n, T* to)
 	{
-		to = new T[size];
-		std::copy_n(from, n, to);
+		CopySpan_(first, n, to);
+		first += n;
 	}
 
-	T FrontOrBackElement_(T* a, T* b, size_t a_index) const
+	static void ConstructSpan_(T*& first, size_t n, T* to)
 	{
-		return a_index ? a[a_index - 1] : b[0];
+		CopySpan_(first, n, to);
+		first += n;
 	}
 
-	T& IthElement_(size_t index) const
+	static void DestroySpan_(T* p, size_t n)
 	{
-		if (index < front_index_)
-			return front_stack_[front_index_ - 1 - index];
-		else
-			return back_stack_[index - front_index_];
+		if (!std::is_trivially_destructible < T >::value)
+			for (size_t i = 0; i < n; ++i)
+				p[i].~T();
+	}
+
+	// constructs n elements from first at the reserved positions from
+	// index on, counted from head_ and wrapping below it, block by block
+	template < class It >
+	void Construct_(size_t index, It& first, size_t n)
+	{
+		size_t done = 0;
+		try
+		{
+			while (done < n)
+			{
+				size_t pos = (head_ + index + done) & Mask_();
+				size_t run = std::min(n - done, BLOCK_SIZE_ - (pos & (BLOCK_SIZE_ - 1)));
+				ConstructSpan_(first, run, map_[pos >> BLOCK_SHIFT_] + (pos & (BLOCK_SIZE_ - 1)));
+				done += run;
+			}
+		}
+		catch (...)
+		{
+			while (done)
+				IthElement_(index + --done).~T();
+			throw;
+		}
 	}
 
-	void Resize_(T*& a, size_t index, size_t size)
+	// moves n elements from index from to index to like memmove; trivially
+	// copyable ones go by a memmove per pair of block segments, others are
+	// move assigned, so the destination must hold live elements
+	void Move_(size_t from, size_t to, size_t n)
 	{
-		T* cur;
-		BuildArrayAndCopy_(a, cur, index, size);
-		delete[] a;
-		a = cur;
+		if (from == to)
+			return;
+		if (!std::is_trivially_copyable < T >::value)
+		{
+			if (from > to)
+				for (size_t i = 0; i < n; ++i)
+					IthElement_(to + i) = std::move(IthElement_(from + i));
+			else
+				for (size_t i = n; i--; )
+					IthElement_(to + i) = std::move(IthElement_(from + i));
+			return;
+		}
+		while (n)
+		{
+			size_t run;
+			if (from > to)
+			{
+				size_t f = (head_ + from) & Mask_(), t = (head_ + to) & Mask_();
+				run = std::min(n, BLOCK_SIZE_ - std::max(f & (BLOCK_SIZE_ - 1), t & (BLOCK_SIZE_ - 1)));
+				std::memmove((void*)&IthElement_(to), (const void*)&IthElement_(from), run * sizeof(T));
+				from += run;
+				to += run;
+			}
+			else
+			{
+				size_t f = (head_ + from + n - 1) & Mask_(), t = (head_ + to + n - 1) & Mask_();
+				run = std::min(n, std::min(f & (BLOCK_SIZE_ - 1), t & (BLOCK_SIZE_ - 1)) + 1);
+				std::memmove((void*)&IthElement_(to + n - run), (const void*)&IthElement_(from + n - run), run * sizeof(T));
+			}
+			n -= run;
+		}
 	}
 
-	void Insert_(T*& a, size_t& index, size_t& size, const T& x)
+	template < class InputIt >
+	void Append_(InputIt first, InputIt last, std::input_iterator_tag)
 	{
-		if (index >= size)
+		size_t n = 0;
+		try
 		{
-			size <<= 1;
-			Resize_(a, index, size);
+			for (; first != last; ++first, ++n)
+				emplace_back(*first);
+		}
+		catch (...)
+		{
+			pop_back(n);
+			throw;
 		}
-		a[index++] = x;
 	}
 
-	void RemoveOtherStack_(T*& a, T*& b, size_t& a_size, size_t& b_size, size_t& a_index, size_t& b_index)
+	template < class ForwardIt >
+	void Append_(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
 	{
-		size_t cur_size = b_index - 1;
-		size_t k1 = cur_size - cur_size / 2;
-		delete[] a;
-		FindSize_(a_size, k1);
-		a = new T[a_size];
-		std::reverse_copy(b + 1, b + k1 + 1, a);
-		a_index = k1;
-		size_t k2 = cur_size / 2;
-		std::copy(b + k1 + 1, b + k1 + k2 + 1, b);
-		b_index = k2;
-		Resize_(b, b_index, b_size);
+		size_t n = std::distance(first, last);
+		reserve(0, n);
+		Construct_(size_, first, n);
+		size_ += n;
 	}
 
-	void Remove_(T*& a, T*& b, size_t& a_size, size_t& b_size, size_t& a_index, size_t& b_index)
+	template < class InputIt >
+	void Insert_(size_t index, InputIt first, InputIt last, std::input_iterator_tag)
 	{
-		if (a_index)
+		size_t n = size_;
+		append(first, last);
+		std::rotate(begin() + index, begin() + n, end());
+	}
+
+	// elements that copy without throwing go straight into a gap opened by
+	// moving one side, others are built at the nearer end and rotated in
+	template < class ForwardIt >
+	void Insert_(size_t index, ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+	{
+		size_t n = std::distance(first, last);
+		bool front = index < size_ - index;
+		reserve(front ? n : 0, front ? 0 : n);
+		if (std::is_trivially_copyable < T >::value &&
+			std::is_nothrow_constructible < T, decltype(*first) >::value)
 		{
-			--a_index;
-			if ((a_size > MIN_SIZE_) && (4 * a_index < a_size))
+			if (front)
+			{
+				head_ = (head_ - n) & Mask_();
+				size_ += n;
+				Move_(n, 0, index);
+			}
+			else
 			{
-				a_size >>= 1;
-				Resize_(a, a_index, a_size);
+				Move_(index, index + n, size_ - index);
+				size_ += n;
 			}
+			Construct_(index, first, n);
+		}
+		else if (front)
+		{
+			Construct_(0 - n, first, n);
+			head_ = (head_ - n) & Mask_();
+			size_ += n;
+			std::rotate(begin(), begin() + n, begin() + n + index);
 		}
 		else
 		{
-			RemoveOtherStack_(a, b, a_size, b_size, a_index, b_index);
+			Construct_(size_, first, n);
+			size_ += n;
+			std::rotate(begin() + index, end() - n, end());
+		}
+	}
+
+	void Swap_(Deque &other)
+	{
+		std::swap(map_, other.map_);
+		std::swap(spare_, other.spare_);
+		std::swap(map_size_, other.map_size_);
+		std::swap(head_, other.head_);
+		std::swap(size_, other.size_);
+		std::swap(blocks_, other.blocks_);
+	}
+
+	size_t Mask_() const
+	{
+		return map_size_ * BLOCK_SIZE_ - 1;
+	}
+
+	T& IthElement_(size_t index) const
+	{
+		size_t pos = (head_ + index) & Mask_();
+		return map_[pos >> BLOCK_SHIFT_][pos & (BLOCK_SIZE_ - 1)];
+	}
+
+	// element index and the live elements sharing its block
+	void Locate_(size_t index, T*& cur, T*& first, T*& last) const
+	{
+		size_t pos = (head_ + index) & Mask_();
+		size_t offset = pos & (BLOCK_SIZE_ - 1);
+		cur = map_[pos >> BLOCK_SHIFT_] + offset;
+		first = cur - std::min(offset, index);
+		last = cur + std::min(BLOCK_SIZE_ - offset, size_ - index);
+	}
+
+	// the number of map slots from the head's block to the last element's
+	size_t UsedBlocks_() const
+	{
+		return size_ ? (((head_ & (BLOCK_SIZE_ - 1)) + size_ - 1) >> BLOCK_SHIFT_) + 1 : 0;
+	}
+
+	// the block holding position pos, taken from the spare blocks or
+	// allocated on first use
+	T* Block_(size_t pos)
+	{
+		T*& block = map_[pos >> BLOCK_SHIFT_];
+		if (!block)
+		{
+			if (spare_)
+				block = PopSpare_();
+			else
+			{
+				block = std::allocator < T >().allocate(BLOCK_SIZE_);
+				++blocks_;
+			}
 		}
+		return block;
+	}
+
+	void FreeBlock_(T* block)
+	{
+		std::allocator < T >().deallocate(block, BLOCK_SIZE_);
+		--blocks_;
+	}
+
+	// spare blocks form a list linked through their own raw storage
+	void PushSpare_(T* block)
+	{
+		std::memcpy((void*)block, &spare_, sizeof(spare_));
+		spare_ = block;
+	}
+
+	T* PopSpare_()
+	{
+		T* block = spare_;
+		std::memcpy(&spare_, (const void*)block, sizeof(spare_));
+		return block;
+	}
+
+	// the elements span at most map_size_ - 1 blocks' worth of positions, so
+	// the first and the last block never share a slot; at that limit the map
+	// grows by the policy's factor
+	void GrowIfFull_()
+	{
+		if (size_ + BLOCK_SIZE_ < map_size_ * BLOCK_SIZE_)
+			return;
+		Remap_(map_size_ ? map_size_ * FACTOR_ : MIN_MAP_SIZE_);
+	}
+
+	// moves the live blocks to the start of a map of map_size slots, which
+	// must hold them; blocks reserved outside them become spare
+	void Remap_(size_t map_size)
+	{
+		T** cur = new T*[map_size]();
+		size_t first = head_ >> BLOCK_SHIFT_;
+		size_t used = UsedBlocks_();
+		for (size_t i = 0; i < map_size_; ++i)
+			if (T* block = map_[(first + i) & (map_size_ - 1)])
+			{
+				if (i < used)
+					cur[i] = block;
+				else
+					PushSpare_(block);
+			}
+		delete[] map_;
+		map_ = cur;
+		map_size_ = map_size;
+		head_ &= BLOCK_SIZE_ - 1;
+	}
+
+	// a block left empty by a pop becomes spare for the next push at either
+	// end unless the blocks already outnumber the live ones by the policy's
+	// ratio, so a queue of steady length stops allocating wherever it moves
+	// on the ring while a drained one gives memory back
+	void Vacate_(size_t slot)
+	{
+		T* block = map_[slot];
+		map_[slot] = nullptr;
+		if (SHRINK_RATIO_ && blocks_ > SHRINK_RATIO_ * ((size_ >> BLOCK_SHIFT_) + 2))
+			FreeBlock_(block);
+		else
+			PushSpare_(block);
 	}
 
-	static const size_t MIN_SIZE_ = 1 << 7;
-	size_t front_size_;
-	size_t back_size_;
-	size_t front_index_;
-	size_t back_index_;
-	T* front_stack_;
-	T* back_stack_;
+	T** map_;
+	T* spare_;
+	size_t map_size_;
+	size_t head_;
+	size_t size_;
+	size_t blocks_;
 };
@@ -0,0 +1,192 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+// bounded queue between exactly one producer thread, which calls push_back,
+// emplace_back and append, and one consumer thread, which calls front,
+// pop_front and empty. Elements live in a ring of capacity() slots, a power
+// of two; head_ and tail_ only ever grow and are reduced modulo the ring on
+// access. Each side owns one index, publishes it with a release store and
+// reads the other's with an acquire load, and keeps its last view of the
+// other index on its own cache line, so it touches the shared line only
+// when that view says the ring is full or empty
+template < class T >
+class SpscQueue
+{
+public:
+	typedef T ValueType;
+
+	explicit SpscQueue(size_t capacity)
+		: mask_(RoundUp_(capacity) - 1)
+		, slots_(std::allocator < T >().allocate(mask_ + 1))
+		, tail_(0)
+		, head_cache_(0)
+		, head_(0)
+		, tail_cache_(0)
+	{
+
+	}
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue &operator=(const SpscQueue&) = delete;
+
+	~SpscQueue()
+	{
+		for (size_t i = head_.load(std::memory_order_relaxed); i != tail_.load(std::memory_order_relaxed); ++i)
+			slots_[i & mask_].~T();
+		std::allocator < T >().deallocate(slots_, mask_ + 1);
+	}
+
+	size_t capacity() const
+	{
+		return mask_ + 1;
+	}
+
+	// a snapshot that may be stale by the time it is used, unless called
+	// while neither side is running
+	size_t size() const
+	{
+		size_t head = head_.load(std::memory_order_acquire);
+		return tail_.load(std::memory_order_acquire) - head;
+	}
+
+	// producer: false, with nothing constructed, when the ring is full
+	bool push_back(const T& x)
+	{
+		return emplace_back(x);
+	}
+
+	bool push_back(T&& x)
+	{
+		return emplace_back(std::move(x));
+	}
+
+	template < class... Args >
+	bool emplace_back(Args&&... args)
+	{
+		size_t tail = tail_.load(std::memory_order_relaxed);
+		if (tail - head_cache_ > mask_)
+		{
+			head_cache_ = head_.load(std::memory_order_acquire);
+			if (tail - head_cache_ > mask_)
+				return false;
+		}
+		new (slots_ + (tail & mask_)) T(std::forward < Args >(args)...);
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// producer: pushes from first on until last or a full ring and returns
+	// the position reached; the batch is published by a single store
+	template < class InputIt >
+	InputIt append(InputIt first, InputIt last)
+	{
+		if (first == last)
+			return first;
+		size_t tail = tail_.load(std::memory_order_relaxed);
+		head_cache_ = head_.load(std::memory_order_acquire);
+		size_t end = head_cache_ + mask_ + 1;
+		size_t i = tail;
+		try
+		{
+			for (; i != end && first != last; ++i, ++first)
+				new (slots_ + (i & mask_)) T(*first);
+		}
+		catch (...)
+		{
+			tail_.store(i, std::memory_order_release);
+			throw;
+		}
+		tail_.store(i, std::memory_order_release);
+		return first;
+	}
+
+	// consumer
+	bool empty() const
+	{
+		size_t head = head_.load(std::memory_order_relaxed);
+		if (head != tail_cache_)
+			return false;
+		tail_cache_ = tail_.load(std::memory_order_acquire);
+		return head == tail_cache_;
+	}
+
+	// consumer: the oldest element, which must exist; it stays valid until
+	// the pop_front that removes it
+	T& front()
+	{
+		return slots_[head_.load(std::memory_order_relaxed) & mask_];
+	}
+
+	const T& front() const
+	{
+		return slots_[head_.load(std::memory_order_relaxed) & mask_];
+	}
+
+	// consumer: removes the oldest element, which must exist
+	void pop_front()
+	{
+		size_t head = head_.load(std::memory_order_relaxed);
+		slots_[head & mask_].~T();
+		head_.store(head + 1, std::memory_order_release);
+	}
+
+	// consumer: moves the oldest element to x and removes it, or returns
+	// false when there is none
+	bool pop_front(T& x)
+	{
+		if (empty())
+			return false;
+		x = std::move(front());
+		pop_front();
+		return true;
+	}
+
+	// consumer: moves up to n elements to out, oldest first, and returns how
+	// many; the slots are handed back by a single store
+	template < class OutputIt >
+	size_t pop_front(OutputIt out, size_t n)
+	{
+		size_t head = head_.load(std::memory_order_relaxed);
+		if (tail_cache_ - head < n)
+			tail_cache_ = tail_.load(std::memory_order_acquire);
+		n = std::min(n, tail_cache_ - head);
+		for (size_t i = head; i != head + n; ++i, ++out)
+		{
+			*out = std::move(slots_[i & mask_]);
+			slots_[i & mask_].~T();
+		}
+		head_.store(head + n, std::memory_order_release);
+		return n;
+	}
+
+private:
+	static const size_t CACHE_LINE_ = 64;
+
+	static size_t RoundUp_(size_t n)
+	{
+		size_t capacity = 1;
+		while (capacity < n)
+			capacity <<= 1;
+		return capacity;
+	}
+
+	// read only after construction, shared by both sides
+	const size_t mask_;
+	T* const slots_;
+	char pad0_[CACHE_LINE_];
+
+	// written by the producer
+	std::atomic < size_t > tail_;
+	size_t head_cache_;
+	char pad1_[CACHE_LINE_];
+
+	// written by the consumer
+	std::atomic < size_t > head_;
+	mutable size_t tail_cache_;
+	char pad2_[CACHE_LINE_];
+};
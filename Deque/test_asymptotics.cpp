@@ -9,46 +9,46 @@ int MyRand()
 	return rand() ^ (rand() << 15);
 }
 
-void MakePopBack(Deque < int > &d, long long &operations)
+// cost of the operation just made, in element slots and pointer copies:
+// each block allocation is charged GetBlockSize() and a map growth copies
+// every block pointer
+long long Count(Deque < int > &d, size_t blocks, size_t map_size, long long &operations)
 {
-	if (d.GetBackIndex() == 0)
-		operations += d.GetFrontSize();
-	else
-		if (d.GetBackIndex() * 4 == d.GetBackSize() && d.GetBackSize() != d.GetMinSize())
-			operations += d.GetBackSize();
-		else
-			operations++;
+	long long cost = 1;
+	if (d.GetBlocks() > blocks)
+		cost += d.GetBlockSize();
+	if (d.GetMapSize() != map_size)
+		cost += map_size;
+	operations += cost;
+	return cost;
+}
+
+long long MakePopBack(Deque < int > &d, long long &operations)
+{
+	size_t blocks = d.GetBlocks(), map_size = d.GetMapSize();
 	d.pop_back();
+	return Count(d, blocks, map_size, operations);
 }
 
-void MakePopFront(Deque < int > &d, long long &operations)
+long long MakePopFront(Deque < int > &d, long long &operations)
 {
-	if (d.GetFrontIndex() == 0)
-		operations += d.GetBackSize();
-	else
-		if (d.GetFrontIndex() * 4 == d.GetFrontSize() && d.GetFrontSize() != d.GetMinSize())
-			operations += d.GetFrontSize();
-		else
-			operations++;
+	size_t blocks = d.GetBlocks(), map_size = d.GetMapSize();
 	d.pop_front();
+	return Count(d, blocks, map_size, operations);
 }
 
-void MakePushBack(Deque < int > &d, int x, long long &operations)
+long long MakePushBack(Deque < int > &d, int x, long long &operations)
 {
-	if (d.GetBackSize() == d.GetBackIndex())
-		operations += 2 * d.GetBackSize();
-	else
-		operations++;
+	size_t blocks = d.GetBlocks(), map_size = d.GetMapSize();
 	d.push_back(x);
+	return Count(d, blocks, map_size, operations);
 }
 
-void MakePushFront(Deque < int > &d, int x, long long &operations)
+long long MakePushFront(Deque < int > &d, int x, long long &operations)
 {
-	if (d.GetFrontSize() == d.GetFrontIndex())
-		operations += 2 * d.GetFrontSize();
-	else
-		operations++;
+	size_t blocks = d.GetBlocks(), map_size = d.GetMapSize();
 	d.push_front(x);
+	return Count(d, blocks, map_size, operations);
 }
 
 std::pair < double, double > f(int n)
@@ -120,13 +120,49 @@ std::pair < double, double > g(int n)
 		1.0 * (clock() - t) / CLOCKS_PER_SEC);
 }
 
+// the two-stack layout rebuilt half of one stack whenever a pop emptied the
+// other, so draining from the far end and alternating ends cost O(n) for a
+// single operation; here the costliest operation after the fill must not
+// grow with n
+std::pair < long long, double > h(int n)
+{
+	long long operations = 0;
+	Deque < int > d;
+	for (int i = 0; i < n; ++i)
+		MakePushBack(d, 1, operations);
+	clock_t t = clock();
+	long long worst = 0;
+	for (int i = 0; i < 4 * n; ++i)
+	{
+		switch (i % 4)
+		{
+		case pop_back:
+			worst = std::max(worst, MakePopBack(d, operations));
+			break;
+		case pop_front:
+			worst = std::max(worst, MakePopFront(d, operations));
+			break;
+		case push_back:
+			worst = std::max(worst, MakePushBack(d, 1, operations));
+			break;
+		case push_front:
+			worst = std::max(worst, MakePushFront(d, 1, operations));
+			break;
+		}
+	}
+	while (!d.empty())
+		worst = std::max(worst, MakePopFront(d, operations));
+	return std::make_pair(worst, 1.0 * (clock() - t) / CLOCKS_PER_SEC);
+}
+
 int main()
 {
 	for (int i = 200; i < 10000000; i *= 2)
 	{
 		std::pair < double, double > c1 = f(i);
 		std::pair < double, double > c2 = g(i);
-		printf("N = %d      C1 = %.3f    time1 = %.3f     C2 = %.3f    time = %.3f\n", i, c1.first, c1.second, c2.first, c2.second);
+		std::pair < long long, double > c3 = h(i);
+		printf("N = %d      C1 = %.3f    time1 = %.3f     C2 = %.3f    time = %.3f     worst = %lld    time3 = %.3f\n", i, c1.first, c1.second, c2.first, c2.second, c3.first, c3.second);
 	}
 	return 0;
 }
@@ -0,0 +1,158 @@
+#include "deque.h"
+#include "spsc_queue.h"
+#include <cstdio>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+const int N_ITEMS = 20000000;
+const int N_ROUNDS = 1000000;
+const size_t CAPACITY = 1 << 14;
+const size_t BATCH = 256;
+
+// the queue the worker used before: a Deque with a mutex around each call
+class LockedDeque
+{
+public:
+	bool push_back(int x)
+	{
+		std::lock_guard < std::mutex > lock(m_);
+		d_.push_back(x);
+		return true;
+	}
+
+	bool pop_front(int &x)
+	{
+		std::lock_guard < std::mutex > lock(m_);
+		if (d_.empty())
+			return false;
+		x = d_.front();
+		d_.pop_front();
+		return true;
+	}
+
+private:
+	std::mutex m_;
+	Deque < int > d_;
+};
+
+double Seconds(std::chrono::steady_clock::time_point t)
+{
+	return std::chrono::duration < double >(std::chrono::steady_clock::now() - t).count();
+}
+
+// items per second from one producer thread to one consumer thread, one
+// element per call
+template < class Queue >
+double Throughput(Queue &q)
+{
+	long long sum = 0;
+	auto t = std::chrono::steady_clock::now();
+	std::thread consumer([&]()
+	{
+		int x;
+		for (int i = 0; i < N_ITEMS; ++i)
+		{
+			while (!q.pop_front(x))
+				std::this_thread::yield();
+			sum += x;
+		}
+	});
+	for (int i = 0; i < N_ITEMS; ++i)
+		while (!q.push_back(i))
+			std::this_thread::yield();
+	consumer.join();
+	double s = Seconds(t);
+	if (sum != 1LL * N_ITEMS * (N_ITEMS - 1) / 2)
+		printf("wrong sum %lld\n", sum);
+	return N_ITEMS / s;
+}
+
+// the same with append and pop_front of up to BATCH elements per call
+double BatchThroughput(SpscQueue < int > &q)
+{
+	long long sum = 0;
+	auto t = std::chrono::steady_clock::now();
+	std::thread consumer([&]()
+	{
+		std::vector < int > buf(BATCH);
+		for (int i = 0; i < N_ITEMS; )
+		{
+			size_t n = q.pop_front(buf.begin(), BATCH);
+			if (!n)
+				std::this_thread::yield();
+			for (size_t j = 0; j < n; ++j)
+				sum += buf[j];
+			i += n;
+		}
+	});
+	std::vector < int > buf(BATCH);
+	for (int i = 0; i < N_ITEMS; )
+	{
+		int n = std::min((int)BATCH, N_ITEMS - i);
+		for (int j = 0; j < n; ++j)
+			buf[j] = i + j;
+		int sent = q.append(buf.begin(), buf.begin() + n) - buf.begin();
+		if (!sent)
+			std::this_thread::yield();
+		i += sent;
+	}
+	consumer.join();
+	double s = Seconds(t);
+	if (sum != 1LL * N_ITEMS * (N_ITEMS - 1) / 2)
+		printf("wrong sum %lld\n", sum);
+	return N_ITEMS / s;
+}
+
+// mean round trip in nanoseconds of one element sent to an echo thread
+// through one queue and back through another
+template < class Queue >
+double Latency(Queue &there, Queue &back)
+{
+	std::thread echo([&]()
+	{
+		int x;
+		for (int i = 0; i < N_ROUNDS; ++i)
+		{
+			while (!there.pop_front(x))
+				std::this_thread::yield();
+			while (!back.push_back(x))
+				std::this_thread::yield();
+		}
+	});
+	auto t = std::chrono::steady_clock::now();
+	int x;
+	for (int i = 0; i < N_ROUNDS; ++i)
+	{
+		while (!there.push_back(i))
+			std::this_thread::yield();
+		while (!back.pop_front(x))
+			std::this_thread::yield();
+	}
+	double s = Seconds(t);
+	echo.join();
+	return s / N_ROUNDS * 1e9;
+}
+
+int main()
+{
+	{
+		LockedDeque q, there, back;
+		double items = Throughput(q);
+		double ns = Latency(there, back);
+		printf("mutex + Deque        %7.1f Mitems/s    round trip = %6.0f ns\n", items / 1e6, ns);
+	}
+	{
+		SpscQueue < int > q(CAPACITY), there(CAPACITY), back(CAPACITY);
+		double items = Throughput(q);
+		double ns = Latency(there, back);
+		printf("SpscQueue            %7.1f Mitems/s    round trip = %6.0f ns\n", items / 1e6, ns);
+	}
+	{
+		SpscQueue < int > q(CAPACITY);
+		double items = BatchThroughput(q);
+		printf("SpscQueue, batch %3d %7.1f Mitems/s\n", (int)BATCH, items / 1e6);
+	}
+	return 0;
+}
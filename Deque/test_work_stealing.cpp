@@ -0,0 +1,100 @@
+#include "work_stealing_deque.h"
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+const int DEPTH = 20;
+const int LEAF_WORK = 2000;
+
+// a task is the depth of its subtree: running it pushes its two children,
+// and a leaf does LEAF_WORK steps of arithmetic, so one root spreads over
+// the workers only through steals
+struct Pool
+{
+	explicit Pool(int threads)
+		: deques(threads)
+		, done(0)
+		, steals(0)
+	{
+		for (auto &d : deques)
+			d.reset(new WorkStealingDeque < int >());
+	}
+
+	std::vector < std::unique_ptr < WorkStealingDeque < int > > > deques;
+	std::atomic < long long > done;
+	std::atomic < long long > steals;
+};
+
+unsigned Leaf(unsigned x)
+{
+	for (int i = 0; i < LEAF_WORK; ++i)
+		x = x * 1103515245 + 12345;
+	return x;
+}
+
+void Work(Pool &pool, int me, long long total, unsigned &sink)
+{
+	WorkStealingDeque < int > &own = *pool.deques[me];
+	unsigned victim = me;
+	int task;
+	while (pool.done.load(std::memory_order_relaxed) < total)
+	{
+		if (!own.pop_back(task))
+		{
+			victim = victim * 1103515245 + 12345;
+			int from = (victim >> 16) % pool.deques.size();
+			if (from == me || !pool.deques[from]->steal(task))
+			{
+				std::this_thread::yield();
+				continue;
+			}
+			pool.steals.fetch_add(1, std::memory_order_relaxed);
+		}
+		if (task)
+		{
+			own.push_back(task - 1);
+			own.push_back(task - 1);
+		}
+		else
+			sink += Leaf(sink);
+		pool.done.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+std::pair < double, long long > Run(int threads)
+{
+	Pool pool(threads);
+	long long total = (2LL << DEPTH) - 1;
+	pool.deques[0]->push_back(DEPTH);
+	std::vector < unsigned > sinks(threads * 16);
+	auto t = std::chrono::steady_clock::now();
+	std::vector < std::thread > workers;
+	for (int i = 1; i < threads; ++i)
+		workers.emplace_back(Work, std::ref(pool), i, total, std::ref(sinks[i * 16]));
+	Work(pool, 0, total, sinks[0]);
+	for (auto &w : workers)
+		w.join();
+	double s = std::chrono::duration < double >(std::chrono::steady_clock::now() - t).count();
+	if (pool.done != total)
+		printf("ran %lld tasks of %lld\n", (long long)pool.done, total);
+	return std::make_pair(s, (long long)pool.steals);
+}
+
+int main()
+{
+	int cores = std::max(1u, std::thread::hardware_concurrency());
+	double base = 0;
+	for (int threads = 1; ; threads = std::min(2 * threads, cores))
+	{
+		std::pair < double, long long > r = Run(threads);
+		if (threads == 1)
+			base = r.first;
+		printf("threads = %3d    time = %.3f    speedup = %5.2f    steals = %lld\n", threads, r.first, base / r.first, r.second);
+		if (threads == cores)
+			break;
+	}
+	return 0;
+}
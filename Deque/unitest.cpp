@@ -1,7 +1,13 @@
 #include "gtest\gtest.h"
 #include "deque.h"
+#include "spsc_queue.h"
+#include "work_stealing_deque.h"
 #include <deque>
 #include <algorithm>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
 
 const int N_LINES_IN_TEST = 1e5;
 
@@ -159,6 +165,115 @@ TEST(Testdeque_operator, access_operator)
 	}
 }
 
+TEST(TestDeque_methods, emplace_move)
+{
+	std::deque < std::string > d1;
+	Deque < std::string > d2;
+	for (int i = 0; i < N_LINES_IN_TEST; ++i)
+	{
+		int x = MyRand();
+		std::string s = std::to_string(x);
+		if (x % 2)
+		{
+			d1.emplace_back(s);
+			d2.emplace_back(s);
+		}
+		else
+		{
+			d1.push_front(s);
+			d2.push_front(std::move(s));
+		}
+		ASSERT_EQ(d1.front(), d2.front());
+		ASSERT_EQ(d1.back(), d2.back());
+	}
+	d2.front() = d1.front() = "front";
+	Deque < std::string > d3(std::move(d2));
+	ASSERT_TRUE(d2.empty());
+	d2 = std::move(d3);
+	ASSERT_TRUE(d3.empty());
+	ASSERT_EQ(d1.size(), d2.size());
+	for (int i = 0; i < N_LINES_IN_TEST; ++i)
+	{
+		ASSERT_EQ(d1[i], d2[i]);
+	}
+}
+
+TEST(TestDeque_methods, reserve_shrink_to_fit)
+{
+	Deque < int, DequeGrowth < 4, 4, 0 > > d;
+	d.reserve(N_LINES_IN_TEST, N_LINES_IN_TEST);
+	size_t blocks = d.GetBlocks();
+	size_t map_size = d.GetMapSize();
+	for (int i = 0; i < N_LINES_IN_TEST; ++i)
+	{
+		d.push_front(i);
+		d.push_back(i);
+	}
+	ASSERT_EQ(blocks, d.GetBlocks());
+	for (int i = 0; i < 10 * N_LINES_IN_TEST; ++i)
+	{
+		d.push_back(i);
+		d.pop_front();
+	}
+	ASSERT_GE(blocks + 1, d.GetBlocks());
+	ASSERT_EQ(map_size, d.GetMapSize());
+	for (int i = 0; i < 2 * N_LINES_IN_TEST - 1; ++i)
+	{
+		d.pop_back();
+	}
+	d.shrink_to_fit();
+	ASSERT_EQ(1, d.GetBlocks());
+	ASSERT_EQ(d.GetMinSize(), d.GetMapSize());
+	ASSERT_EQ(10 * N_LINES_IN_TEST - 2 * N_LINES_IN_TEST, d.front());
+	d.pop_back();
+	d.shrink_to_fit();
+	ASSERT_EQ(0, d.GetBlocks());
+}
+
+TEST(TestDeque_methods, insert_erase_ranges)
+{
+	std::vector < int > v(N_LINES_IN_TEST);
+	for (int i = 0; i < N_LINES_IN_TEST; ++i)
+	{
+		v[i] = MyRand();
+	}
+	std::deque < int > d1(v.begin(), v.end());
+	Deque < int > d2(v.begin(), v.end());
+	for (int i = 0; i < 100; ++i)
+	{
+		// MyRand() is negative when rand() << 15 overflows, so both are drawn
+		// unsigned
+		size_t x = (unsigned)MyRand() % (d1.size() + 1);
+		size_t y = (unsigned)MyRand() % 1000;
+		if (i % 2)
+		{
+			y = std::min(y, v.size());
+			d1.insert(d1.begin() + x, v.begin(), v.begin() + y);
+			d2.insert(d2.begin() + x, v.data(), v.data() + y);
+		}
+		else
+		{
+			y = std::min(y, d1.size() - x);
+			d1.erase(d1.begin() + x, d1.begin() + x + y);
+			d2.erase(d2.begin() + x, d2.begin() + x + y);
+		}
+		ASSERT_EQ(d1.size(), d2.size());
+	}
+	d1.insert(d1.end(), v.begin(), v.end());
+	d2.append(v.begin(), v.end());
+	for (size_t i = 0; i < d1.size(); ++i)
+	{
+		ASSERT_EQ(d1[i], d2[i]);
+	}
+	d1.erase(d1.begin(), d1.begin() + N_LINES_IN_TEST / 2);
+	d2.pop_front(N_LINES_IN_TEST / 2);
+	d1.erase(d1.end() - N_LINES_IN_TEST / 3, d1.end());
+	d2.pop_back(N_LINES_IN_TEST / 3);
+	ASSERT_EQ(d1.size(), d2.size());
+	ASSERT_EQ(d1.front(), d2.front());
+	ASSERT_EQ(d1.back(), d2.back());
+}
+
 class Testdeque_iterator : public ::testing::Test
 {
 public:
@@ -316,6 +431,111 @@ TEST_F(Testdeque_iterator, iterator_ge)
 	}
 }
 
+TEST_F(Testdeque_iterator, iterator_segments)
+{
+	int i = 0;
+	for (auto span : d2.segments())
+	{
+		for (int *p = span.first; p != span.second; ++p, ++i)
+			ASSERT_EQ(d1[i], *p);
+	}
+	ASSERT_EQ(N_LINES_IN_TEST, i);
+	i = 0;
+	d2.for_each_segment([&](const int *first, const int *last)
+	{
+		ASSERT_EQ(first, &*(itb2 + i));
+		ASSERT_EQ(last, (itb2 + i).segment_end());
+		i += last - first;
+	});
+	ASSERT_EQ(N_LINES_IN_TEST, i);
+	std::sort(d1.begin(), d1.end());
+	std::sort(d2.begin(), d2.end());
+	for (int i = 0; i < N_LINES_IN_TEST; ++i)
+		ASSERT_EQ(d1[i], d2[i]);
+}
+
+TEST(TestSpscQueue, producer_consumer)
+{
+	SpscQueue < int > q(1000);
+	ASSERT_EQ(1024, q.capacity());
+	std::thread producer([&q]()
+	{
+		std::vector < int > batch(100);
+		for (int i = 0; i < N_LINES_IN_TEST; )
+		{
+			if (i % 2)
+			{
+				for (int j = 0; j < 100; ++j)
+					batch[j] = i + j;
+				int n = std::min(100, N_LINES_IN_TEST - i);
+				i += q.append(batch.begin(), batch.begin() + n) - batch.begin();
+			}
+			else if (q.push_back(i))
+				++i;
+		}
+	});
+	std::vector < int > got;
+	while ((int)got.size() < N_LINES_IN_TEST)
+	{
+		if (got.size() % 3)
+		{
+			int x;
+			if (q.pop_front(x))
+				got.push_back(x);
+		}
+		else if (!q.empty())
+		{
+			got.push_back(q.front());
+			q.pop_front();
+		}
+	}
+	producer.join();
+	ASSERT_TRUE(q.empty());
+	for (int i = 0; i < N_LINES_IN_TEST; ++i)
+		ASSERT_EQ(i, got[i]);
+}
+
+TEST(TestWorkStealingDeque, owner_and_thieves)
+{
+	WorkStealingDeque < int > d(2);
+	std::vector < std::atomic < int > > taken(N_LINES_IN_TEST);
+	for (int i = 0; i < N_LINES_IN_TEST; ++i)
+		taken[i] = 0;
+	std::atomic < bool > done(false);
+	std::vector < std::thread > thieves;
+	for (int k = 0; k < 3; ++k)
+	{
+		thieves.emplace_back([&]()
+		{
+			int x;
+			while (!done)
+			{
+				if (d.steal(x))
+					++taken[x];
+				else
+					std::this_thread::yield();
+			}
+		});
+	}
+	int x;
+	for (int i = 0; i < N_LINES_IN_TEST; ++i)
+	{
+		d.push_back(i);
+		if (MyRand() % 3 == 0 && d.pop_back(x))
+			++taken[x];
+	}
+	while (!d.empty())
+	{
+		if (d.pop_back(x))
+			++taken[x];
+	}
+	done = true;
+	for (auto &t : thieves)
+		t.join();
+	for (int i = 0; i < N_LINES_IN_TEST; ++i)
+		ASSERT_EQ(1, taken[i]);
+}
+
 int main(int argc, char *argv[])
 {
 	::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,188 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+// Chase-Lev work-stealing deque with the memory orders of Le, Pop, Cohen and
+// Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory
+// Models". One owner thread calls push_back and pop_back at the bottom; any
+// number of thieves call steal at the top. Elements sit in a circular array
+// indexed by ever-growing top_ and bottom_, so only the last element is
+// contended, and the owner doubles the array when it fills.
+//
+// A thief may still be reading the array it loaded when the owner replaces
+// it, so replaced arrays are not freed at once but kept on a list until the
+// deque is destroyed; since each array is twice the previous one, they never
+// take more memory than the live array does.
+//
+// Elements are read racily and copied as they stand, so T must be
+// trivially copyable; a pointer to a task is the usual choice
+template < class T >
+class WorkStealingDeque
+{
+	static_assert(std::is_trivially_copyable < T >::value,
+		"WorkStealingDeque holds trivially copyable elements");
+
+public:
+	typedef T ValueType;
+
+	explicit WorkStealingDeque(size_t capacity = 64)
+		: top_(0)
+		, bottom_(0)
+		, array_(new Array_(RoundUp_(capacity), nullptr))
+	{
+
+	}
+
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque &operator=(const WorkStealingDeque&) = delete;
+
+	~WorkStealingDeque()
+	{
+		Array_* a = array_.load(std::memory_order_relaxed);
+		while (a)
+		{
+			Array_* retired = a->retired;
+			delete a;
+			a = retired;
+		}
+	}
+
+	// a snapshot, exact only while no other thread is running
+	size_t size() const
+	{
+		long long b = bottom_.load(std::memory_order_relaxed);
+		long long t = top_.load(std::memory_order_relaxed);
+		return b > t ? (size_t)(b - t) : 0;
+	}
+
+	bool empty() const
+	{
+		return !size();
+	}
+
+	size_t capacity() const
+	{
+		return array_.load(std::memory_order_relaxed)->mask + 1;
+	}
+
+	// owner
+	void push_back(T x)
+	{
+		long long b = bottom_.load(std::memory_order_relaxed);
+		long long t = top_.load(std::memory_order_acquire);
+		Array_* a = array_.load(std::memory_order_relaxed);
+		if (b - t > (long long)a->mask)
+			a = Grow_(a, t, b);
+		a->Put(b, x);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom_.store(b + 1, std::memory_order_relaxed);
+	}
+
+	// owner: takes the newest element, or returns false when there is none
+	bool pop_back(T& x)
+	{
+		long long b = bottom_.load(std::memory_order_relaxed) - 1;
+		Array_* a = array_.load(std::memory_order_relaxed);
+		bottom_.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		long long t = top_.load(std::memory_order_relaxed);
+		if (t > b)
+		{
+			bottom_.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+		T y = a->Get(b);
+		if (t == b)
+		{
+			// the last element, which a thief may be taking at the same time
+			bool won = top_.compare_exchange_strong(t, t + 1,
+				std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom_.store(b + 1, std::memory_order_relaxed);
+			if (!won)
+				return false;
+		}
+		x = y;
+		return true;
+	}
+
+	// thief: takes the oldest element, or returns false when there is none
+	// or another thread took it first, in which case it may be worth trying
+	// again
+	bool steal(T& x)
+	{
+		long long t = top_.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		long long b = bottom_.load(std::memory_order_acquire);
+		if (t >= b)
+			return false;
+		Array_* a = array_.load(std::memory_order_acquire);
+		T y = a->Get(t);
+		if (!top_.compare_exchange_strong(t, t + 1,
+			std::memory_order_seq_cst, std::memory_order_relaxed))
+			return false;
+		x = y;
+		return true;
+	}
+
+private:
+	static const size_t CACHE_LINE_ = 64;
+
+	struct Array_
+	{
+		Array_(size_t capacity, Array_* retired)
+			: mask(capacity - 1)
+			, slots(new std::atomic < T >[capacity])
+			, retired(retired)
+		{
+
+		}
+
+		~Array_()
+		{
+			delete[] slots;
+		}
+
+		T Get(long long i) const
+		{
+			return slots[i & mask].load(std::memory_order_relaxed);
+		}
+
+		void Put(long long i, T x)
+		{
+			slots[i & mask].store(x, std::memory_order_relaxed);
+		}
+
+		size_t mask;
+		std::atomic < T >* slots;
+		Array_* retired;
+	};
+
+	static size_t RoundUp_(size_t n)
+	{
+		size_t capacity = 2;
+		while (capacity < n)
+			capacity <<= 1;
+		return capacity;
+	}
+
+	// copies the elements to an array twice as large, which keeps the old
+	// one on its retired list
+	Array_* Grow_(Array_* a, long long t, long long b)
+	{
+		Array_* cur = new Array_(2 * (a->mask + 1), a);
+		for (long long i = t; i < b; ++i)
+			cur->Put(i, a->Get(i));
+		array_.store(cur, std::memory_order_release);
+		return cur;
+	}
+
+	// taken by thieves
+	std::atomic < long long > top_;
+	char pad0_[CACHE_LINE_];
+
+	// written by the owner
+	std::atomic < long long > bottom_;
+	std::atomic < Array_* > array_;
+	char pad1_[CACHE_LINE_];
+};